@@ -226,6 +226,7 @@ JSS(binary);                      // in: AccountTX, LedgerEntry,
 JSS(blob);                        // out: ValidatorList
 JSS(blobs_v2);                    // out: ValidatorList
                                   // in: UNL
+JSS(book_page_hit_rate);          // out: GetCounts
 JSS(books);                       // in: Subscribe, Unsubscribe
 JSS(both);                        // in: Subscribe, Unsubscribe
 JSS(both_sides);                  // in: Subscribe, Unsubscribe
@@ -281,6 +282,9 @@ JSS(date);                    // out: tx/Transaction, NetworkOPs
 JSS(dbKBLedger);              // out: getCounts
 JSS(dbKBTotal);               // out: getCounts
 JSS(dbKBTransaction);         // out: getCounts
+JSS(dbTxReadCheckouts);       // out: getCounts
+JSS(dbTxReadSessions);        // out: getCounts
+JSS(dbTxReadWaits);           // out: getCounts
 JSS(debug_signing);           // in: TransactionSign
 JSS(deletion_blockers_only);  // in: AccountObjects
 JSS(delivered_amount);        // out: insertDeliveredAmount
@@ -356,6 +360,7 @@ JSS(good);                  // out: RPCVersion
 JSS(hash);                  // out: NetworkOPs, InboundLedger,
                             //      LedgerToJson, STTx; field
 JSS(hashes);                // in: AccountObjects
+JSS(hashes_known);          // out: NetworkOPs
 JSS(have_header);           // out: InboundLedger
 JSS(have_state);            // out: InboundLedger
 JSS(have_transactions);     // out: InboundLedger
@@ -363,6 +368,7 @@ JSS(high);                  // out: BookChanges
 JSS(highest_sequence);      // out: AccountInfo
 JSS(highest_ticket);        // out: AccountInfo
 JSS(historical_perminute);  // historical_perminute.
+JSS(history_backfill);      // out: NetworkOPs
 JSS(hostid);                // out: NetworkOPs
 JSS(hotwallet);             // in: GatewayBalances
 JSS(id);                    // websocket.
@@ -424,7 +430,14 @@ JSS(ledger_index_max);            // in, out: AccountTx*
 JSS(ledger_index_min);            // in, out: AccountTx*
 JSS(ledger_max);                  // in, out: AccountTx*
 JSS(ledger_min);                  // in, out: AccountTx*
+JSS(ledger_replay_build_ms);      // out: GetCounts
+JSS(ledger_replay_built);         // out: GetCounts
+JSS(ledger_replay_gaps);          // out: GetCounts
+JSS(ledger_replay_ledgers);       // out: GetCounts
+JSS(ledger_replay_skipped_gaps);  // out: GetCounts
+JSS(ledger_replay_skipped_ledgers);  // out: GetCounts
 JSS(ledger_time);                 // out: NetworkOPs
+JSS(ledgers_saved);               // out: NetworkOPs
 JSS(LEDGER_ENTRY_TYPES);          // out: RPC server_definitions
                                   // matches definitions.json format
 JSS(levels);                      // LogLevels
@@ -509,6 +522,7 @@ JSS(node_read_retries);          // out: GetCounts
 JSS(node_reads_hit);             // out: GetCounts
 JSS(node_reads_total);           // out: GetCounts
 JSS(node_reads_duration_us);     // out: GetCounts
+JSS(node_reads_latency_us);      // out: GetCounts
 JSS(node_size);                  // out: server_info
 JSS(nodestore);                  // out: GetCounts
 JSS(node_writes);                // out: GetCounts
@@ -528,6 +542,10 @@ JSS(open);                       // out: handlers/Ledger
 JSS(open_ledger_cost);           // out: SubmitTransaction
 JSS(open_ledger_fee);            // out: TxQ
 JSS(open_ledger_level);          // out: TxQ
+JSS(open_ledger_replay_locked_ms);  // out: getCounts
+JSS(open_ledger_replay_ms);      // out: getCounts
+JSS(open_ledger_replayed);       // out: getCounts
+JSS(open_ledger_replayed_locked);  // out: getCounts
 JSS(oracle);                     // in: LedgerEntry
 JSS(oracles);                    // in: get_aggregate_price
 JSS(oracle_document_id);         // in: get_aggregate_price
@@ -551,6 +569,7 @@ JSS(peers);                       // out: InboundLedger, handlers/Peers, Overlay
 JSS(peer_disconnects);            // Severed peer connection counter.
 JSS(peer_disconnects_resources);  // Severed peer connections because of
                                   // excess resource consumption.
+JSS(pending_saves);               // out: GetCounts
 JSS(port);                        // in: Connect, out: NetworkOPs
 JSS(ports);                       // out: NetworkOPs
 JSS(previous);                    // out: Reservations
@@ -603,6 +622,7 @@ JSS(role);                  // out: Ping.cpp
 JSS(rpc);
 JSS(rt_accounts);  // in: Subscribe, Unsubscribe
 JSS(running_duration_us);
+JSS(saved_perminute);           // out: NetworkOPs
 JSS(search_depth);              // in: RipplePathFind
 JSS(searched_all);              // out: Tx
 JSS(secret);                    // in: TransactionSign,
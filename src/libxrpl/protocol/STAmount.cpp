@@ -28,6 +28,9 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/multiprecision/cpp_int.hpp>
 #include <boost/regex.hpp>
+#include <array>
+#include <bit>
+#include <cassert>
 #include <iostream>
 #include <iterator>
 #include <memory>
@@ -61,6 +64,41 @@ static const std::uint64_t tenTo14 = 100000000000000ull;
 static const std::uint64_t tenTo14m1 = tenTo14 - 1;
 static const std::uint64_t tenTo17 = tenTo14 * 1000;
 
+static constexpr std::array<std::uint64_t, 20> powersOfTen = [] {
+    std::array<std::uint64_t, 20> result{};
+    std::uint64_t p = 1;
+    for (auto& r : result)
+    {
+        r = p;
+        p *= 10;
+    }
+    return result;
+}();
+
+// The number of decimal digits in a non-zero value.
+static int
+decimalDigits(std::uint64_t value)
+{
+    // 1233 / 4096 approximates log10(2), which gives the digit count from
+    // the bit width, or one less. A single comparison settles which.
+    int const guess = ((64 - std::countl_zero(value)) * 1233) >> 12;
+    return guess + (value >= powersOfTen[guess]);
+}
+
+// Scale a non-zero native mantissa up into the range of IOU mantissas,
+// [cMinValue, cMaxValue], in one step instead of one digit at a time.
+static void
+scaleNative(std::uint64_t& value, int& offset)
+{
+    assert(value != 0);
+    if (value < STAmount::cMinValue)
+    {
+        int const shift = 16 - decimalDigits(value);
+        value *= powersOfTen[shift];
+        offset -= shift;
+    }
+}
+
 //------------------------------------------------------------------------------
 static std::int64_t
 getSNValue(STAmount const& amount)
@@ -797,19 +835,25 @@ STAmount::canonicalize()
         return;
     }
 
-    while ((mValue < cMinValue) && (mOffset > cMinOffset))
+    // Bring the mantissa into range in one step, rather than a digit at a
+    // time, with the same result and the same overflow check.
+    if (int const digits = decimalDigits(mValue); digits < 16)
     {
-        mValue *= 10;
-        --mOffset;
+        int const shift = std::min(16 - digits, mOffset - cMinOffset);
+        if (shift > 0)
+        {
+            mValue *= powersOfTen[shift];
+            mOffset -= shift;
+        }
     }
-
-    while (mValue > cMaxValue)
+    else if (digits > 16)
     {
-        if (mOffset >= cMaxOffset)
+        int const shift = digits - 16;
+        if (mOffset + shift - 1 >= cMaxOffset)
             Throw<std::runtime_error>("value overflow");
 
-        mValue /= 10;
-        ++mOffset;
+        mValue /= powersOfTen[shift];
+        mOffset += shift;
     }
 
     if ((mOffset < cMinOffset) || (mValue < cMinValue))
@@ -1113,6 +1157,16 @@ operator-(STAmount const& value)
 //
 //------------------------------------------------------------------------------
 
+// Where the compiler provides a native 128-bit integer, use it: the
+// multiplication is a single instruction and the division a short library
+// call, where boost::multiprecision works limb by limb. Both produce
+// exactly the same values.
+#ifdef __SIZEOF_INT128__
+using uint128_t = unsigned __int128;
+#else
+using uint128_t = boost::multiprecision::uint128_t;
+#endif
+
 // Calculate (a * b) / c when all three values are 64-bit
 // without loss of precision:
 static std::uint64_t
@@ -1121,9 +1175,7 @@ muldiv(
     std::uint64_t multiplicand,
     std::uint64_t divisor)
 {
-    boost::multiprecision::uint128_t ret;
-
-    boost::multiprecision::multiply(ret, multiplier, multiplicand);
+    uint128_t ret = static_cast<uint128_t>(multiplier) * multiplicand;
     ret /= divisor;
 
     if (ret > std::numeric_limits<std::uint64_t>::max())
@@ -1143,9 +1195,7 @@ muldiv_round(
     std::uint64_t divisor,
     std::uint64_t rounding)
 {
-    boost::multiprecision::uint128_t ret;
-
-    boost::multiprecision::multiply(ret, multiplier, multiplicand);
+    uint128_t ret = static_cast<uint128_t>(multiplier) * multiplicand;
     ret += rounding;
     ret /= divisor;
 
@@ -1175,23 +1225,10 @@ divide(STAmount const& num, STAmount const& den, Issue const& issue)
     int denOffset = den.exponent();
 
     if (num.native())
-    {
-        while (numVal < STAmount::cMinValue)
-        {
-            // Need to bring into range
-            numVal *= 10;
-            --numOffset;
-        }
-    }
+        scaleNative(numVal, numOffset);
 
     if (den.native())
-    {
-        while (denVal < STAmount::cMinValue)
-        {
-            denVal *= 10;
-            --denOffset;
-        }
-    }
+        scaleNative(denVal, denOffset);
 
     // We divide the two mantissas (each is between 10^15
     // and 10^16). To maintain precision, we multiply the
@@ -1236,22 +1273,10 @@ multiply(STAmount const& v1, STAmount const& v2, Issue const& issue)
     int offset2 = v2.exponent();
 
     if (v1.native())
-    {
-        while (value1 < STAmount::cMinValue)
-        {
-            value1 *= 10;
-            --offset1;
-        }
-    }
+        scaleNative(value1, offset1);
 
     if (v2.native())
-    {
-        while (value2 < STAmount::cMinValue)
-        {
-            value2 *= 10;
-            --offset2;
-        }
-    }
+        scaleNative(value2, offset2);
 
     // We multiply the two mantissas (each is between 10^15
     // and 10^16), so their product is in the 10^30 to 10^32
@@ -1423,22 +1448,10 @@ mulRoundImpl(
     int offset1 = v1.exponent(), offset2 = v2.exponent();
 
     if (v1.native())
-    {
-        while (value1 < STAmount::cMinValue)
-        {
-            value1 *= 10;
-            --offset1;
-        }
-    }
+        scaleNative(value1, offset1);
 
     if (v2.native())
-    {
-        while (value2 < STAmount::cMinValue)
-        {
-            value2 *= 10;
-            --offset2;
-        }
-    }
+        scaleNative(value2, offset2);
 
     bool const resultNegative = v1.negative() != v2.negative();
 
@@ -1526,22 +1539,10 @@ divRoundImpl(
     int numOffset = num.exponent(), denOffset = den.exponent();
 
     if (num.native())
-    {
-        while (numVal < STAmount::cMinValue)
-        {
-            numVal *= 10;
-            --numOffset;
-        }
-    }
+        scaleNative(numVal, numOffset);
 
     if (den.native())
-    {
-        while (denVal < STAmount::cMinValue)
-        {
-            denVal *= 10;
-            --denOffset;
-        }
-    }
+        scaleNative(denVal, denOffset);
 
     bool const resultNegative = (num.negative() != den.negative());
 
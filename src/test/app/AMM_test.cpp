@@ -6862,6 +6862,48 @@ private:
         }
     }
 
+    void
+    testAMMAccountHolds()
+    {
+        testcase("AMM account holds");
+        using namespace jtx;
+
+        testAMM([&](AMM& ammAlice, Env& env) {
+            auto const ammID = ammAlice.ammAccount();
+            // The pool's IOU balance reads as zero exactly when isFrozen
+            // says the AMM's trust line is frozen.
+            auto expectHolds = [&](STAmount const& expected) {
+                auto const view = env.current();
+                BEAST_EXPECT(
+                    ammAccountHolds(*view, ammID, xrpIssue()) ==
+                    XRP(10000).value());
+                auto const held = ammAccountHolds(*view, ammID, USD.issue());
+                BEAST_EXPECT(held == expected);
+                BEAST_EXPECT(
+                    (held == beast::zero) ==
+                    isFrozen(*view, ammID, USD.currency, gw.id()));
+            };
+
+            expectHolds(USD(10000));
+
+            env(fset(gw, asfGlobalFreeze));
+            env.close();
+            expectHolds(USD(0));
+            env(fclear(gw, asfGlobalFreeze));
+            env.close();
+            expectHolds(USD(10000));
+
+            env(trust(
+                gw, STAmount{Issue{USD.currency, ammID}, 0}, tfSetFreeze));
+            env.close();
+            expectHolds(USD(0));
+            env(trust(
+                gw, STAmount{Issue{USD.currency, ammID}, 0}, tfClearFreeze));
+            env.close();
+            expectHolds(USD(10000));
+        });
+    }
+
     void
     run() override
     {
@@ -6908,6 +6950,7 @@ private:
         testFixAMMOfferBlockedByLOB(all - fixAMMv1_1);
         testLPTokenBalance(all);
         testLPTokenBalance(all - fixAMMv1_1);
+        testAMMAccountHolds();
     }
 };
 
@@ -0,0 +1,225 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <test/jtx.h>
+#include <xrpld/app/ledger/LedgerMaster.h>
+#include <xrpld/app/ledger/detail/HistoryBackfill.h>
+#include <xrpl/beast/clock/manual_clock.h>
+#include <xrpl/beast/unit_test.h>
+#include <xrpl/protocol/jss.h>
+
+#include <set>
+
+namespace ripple {
+namespace test {
+
+class HistoryBackfill_test : public beast::unit_test::suite
+{
+    using clock_type = beast::manual_clock<std::chrono::steady_clock>;
+
+    void
+    testLearn()
+    {
+        using namespace jtx;
+
+        testcase("learn");
+
+        Env env(*this);
+        while (env.closed()->seq() < 600)
+            env.close();
+
+        auto& lm = env.app().getLedgerMaster();
+        auto const top = env.closed();
+        auto const seq = top->seq();
+
+        clock_type clock;
+        HistoryBackfill backfill(4, clock);
+        BEAST_EXPECT(backfill.learn(*top, 2) > 256);
+
+        // The 256 ledgers before it, and the flag ledgers below
+        for (auto s = seq - 256; s <= seq; ++s)
+        {
+            auto const hash = backfill.hashOf(s);
+            BEAST_EXPECT(hash && *hash == lm.getLedgerBySeq(s)->info().hash);
+        }
+        BEAST_EXPECT(!backfill.hashOf(seq - 257));
+        BEAST_EXPECT(
+            backfill.hashOf(256) == lm.getLedgerBySeq(256)->info().hash);
+
+        // Nothing below the floor
+        HistoryBackfill above(4, clock);
+        above.learn(*top, seq - 10);
+        BEAST_EXPECT(above.hashOf(seq - 10));
+        BEAST_EXPECT(!above.hashOf(seq - 11));
+        BEAST_EXPECT(!above.hashOf(256));
+
+        // Learning from the flag ledger reveals the ledgers before it
+        BEAST_EXPECT(backfill.learn(*lm.getLedgerBySeq(256), 2) == 254);
+        BEAST_EXPECT(backfill.hashOf(2) == lm.getLedgerBySeq(2)->info().hash);
+        BEAST_EXPECT(backfill.learn(*top, 2) == 0);
+    }
+
+    void
+    testNext()
+    {
+        using namespace jtx;
+
+        testcase("next");
+
+        Env env(*this);
+        while (env.closed()->seq() < 600)
+            env.close();
+
+        auto& lm = env.app().getLedgerMaster();
+        auto const top = env.closed();
+        auto const missing = top->seq() - 1;
+
+        clock_type clock;
+        HistoryBackfill backfill(4, clock);
+        BEAST_EXPECT(backfill.getJson().isNull());
+        backfill.learn(*top, 2);
+
+        // The ledgers written next, and the flag ledger whose predecessors
+        // are not known, in turn.
+        auto targets = backfill.next(missing, 2);
+        if (!BEAST_EXPECT(targets.size() == 4))
+            return;
+        BEAST_EXPECT(targets[0].first == missing);
+        BEAST_EXPECT(targets[1].first == 256);
+        BEAST_EXPECT(targets[2].first == missing - 1);
+        BEAST_EXPECT(targets[3].first == missing - 2);
+        for (auto const& [seq, hash] : targets)
+            BEAST_EXPECT(hash == lm.getLedgerBySeq(seq)->info().hash);
+        BEAST_EXPECT(backfill.inFlight() == 4);
+
+        // No more than four at once
+        BEAST_EXPECT(backfill.next(missing, 2).empty());
+
+        // The flag ledger arrives
+        auto const flag = targets[1].second;
+        auto const done = backfill.reap(
+            [&flag](uint256 const& hash) { return hash != flag; });
+        BEAST_EXPECT(done.size() == 1 && done[0].first == 256);
+        BEAST_EXPECT(backfill.inFlight() == 3);
+        backfill.learn(*lm.getLedgerBySeq(256), 2);
+
+        // It is not asked for again, and is no longer an anchor
+        targets = backfill.next(missing, 2);
+        BEAST_EXPECT(targets.size() == 1 && targets[0].first == missing - 3);
+
+        // Writing a ledger frees its place
+        backfill.onSaved(missing);
+        BEAST_EXPECT(!backfill.hashOf(missing));
+        BEAST_EXPECT(backfill.inFlight() == 3);
+        targets = backfill.next(missing - 1, 2);
+        BEAST_EXPECT(targets.size() == 1 && targets[0].first == missing - 4);
+
+        // A moved gap drops the requests outside it
+        targets = backfill.next(missing - 3, 2);
+        BEAST_EXPECT(backfill.inFlight() == 4);
+        BEAST_EXPECT(targets.size() == 2 && targets[0].first == missing - 5);
+
+        auto const json = backfill.getJson();
+        BEAST_EXPECT(json[jss::seq].asUInt() == missing - 3);
+        BEAST_EXPECT(json[jss::min_ledger].asUInt() == 2);
+        BEAST_EXPECT(json[jss::acquiring].asUInt() == 4);
+        BEAST_EXPECT(json[jss::ledgers_saved].asUInt() == 1);
+    }
+
+    void
+    testPass()
+    {
+        using namespace jtx;
+
+        testcase("pass");
+
+        Env env(*this);
+        while (env.closed()->seq() < 600)
+            env.close();
+
+        auto& lm = env.app().getLedgerMaster();
+        auto const top = env.closed();
+        auto const missing = top->seq() - 1;
+
+        clock_type clock;
+        HistoryBackfill backfill(4, clock);
+        backfill.learn(*top, 2);
+
+        // Acquisitions finish some time after they are started, and the
+        // ledgers are only handed out by the acquisition.
+        std::set<uint256> started;
+        std::set<uint256> finished;
+        auto const pending = [&](uint256 const& hash) {
+            return started.count(hash) && !finished.count(hash);
+        };
+        auto const acquire = [&](HistoryBackfill::Target const& target)
+            -> std::shared_ptr<ReadView const> {
+            started.insert(target.second);
+            if (!finished.count(target.second))
+                return {};
+            return lm.getLedgerBySeq(target.first);
+        };
+
+        backfill.pass(missing, 2, pending, acquire);
+        BEAST_EXPECT(started.size() == 4);
+        BEAST_EXPECT(backfill.inFlight() == 4);
+        BEAST_EXPECT(!backfill.isAcquired(256));
+        BEAST_EXPECT(!backfill.hashOf(255));
+
+        // Nothing finished, so nothing more is started
+        backfill.pass(missing, 2, pending, acquire);
+        BEAST_EXPECT(started.size() == 4);
+
+        // The anchor finishes while other ledgers are still pending
+        auto const anchor = *backfill.hashOf(256);
+        BEAST_EXPECT(started.count(anchor));
+        finished.insert(anchor);
+        backfill.pass(missing, 2, pending, acquire);
+        BEAST_EXPECT(backfill.isAcquired(256));
+        BEAST_EXPECT(
+            backfill.hashOf(255) == lm.getLedgerBySeq(255)->info().hash);
+        BEAST_EXPECT(backfill.hashOf(2) == lm.getLedgerBySeq(2)->info().hash);
+
+        // Its place went to the next ledger to write
+        BEAST_EXPECT(started.size() == 5);
+        BEAST_EXPECT(started.count(*backfill.hashOf(missing - 3)));
+        BEAST_EXPECT(backfill.inFlight() == 4);
+
+        // A ledger written next finishes, and may be written
+        auto const near = *backfill.hashOf(missing);
+        finished.insert(near);
+        backfill.pass(missing, 2, pending, acquire);
+        BEAST_EXPECT(backfill.isAcquired(missing));
+        BEAST_EXPECT(!backfill.isAcquired(missing - 1));
+    }
+
+public:
+    void
+    run() override
+    {
+        testLearn();
+        testNext();
+        testPass();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(HistoryBackfill, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
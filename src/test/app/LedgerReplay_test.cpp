@@ -872,6 +872,7 @@ struct NetworkOfTwo
  * -- process a bad skip list
  * -- process a bad ledger delta
  * -- replay ledger ranges with different overlaps
+ * -- replay a range longer than a task in a chain of tasks
  *
  * LedgerReplayerTimeout_test:
  * -- timeouts of SkipListAcquire
@@ -1051,6 +1052,14 @@ struct LedgerReplayer_test : public beast::unit_test::suite
         BEAST_EXPECT(tp9.canMergeInto(tp20));
         BEAST_EXPECT(!tp20.canMergeInto(tp10));
         BEAST_EXPECT(!tp20.canMergeInto(tp9));
+
+        // the tasks chained below count too
+        LedgerReplayTask::TaskParameter tp30(
+            InboundLedger::Reason::GENERIC, uint256(20), 30);
+        BEAST_EXPECT(!tp30.canMergeInto(tp20));
+        tp20.ledgersBelow_ = 11;
+        BEAST_EXPECT(tp30.canMergeInto(tp20));
+        BEAST_EXPECT(!tp20.canMergeInto(tp10));
     }
 
     void
@@ -1059,7 +1068,7 @@ struct LedgerReplayer_test : public beast::unit_test::suite
         testcase("config test");
         {
             Config c;
-            BEAST_EXPECT(c.LEDGER_REPLAY == false);
+            BEAST_EXPECT(c.LEDGER_REPLAY == true);
         }
 
         {
@@ -1343,6 +1352,8 @@ struct LedgerReplayer_test : public beast::unit_test::suite
             InboundLedger::Reason::GENERIC, finalHash, totalReplay);
 
         auto delta = net.client.findLedgerDeltaAcquire(l->info().parentHash);
+        BEAST_EXPECT(
+            net.client.replayer.wantsReplayDelta(l->info().parentHash));
         delta->processData(
             l->info(),  // wrong ledger info
             std::map<std::uint32_t, std::shared_ptr<STTx const>>());
@@ -1445,6 +1456,55 @@ struct LedgerReplayer_test : public beast::unit_test::suite
         BEAST_EXPECT(net.client.countsAsExpected(0, 0, 0));
     }
 
+    void
+    testReplayChained()
+    {
+        testcase("replay a long range in chained tasks");
+        int totalReplay = 300;
+        NetworkOfTwo net(
+            *this,
+            {totalReplay + 1},
+            PeerSetBehavior::Good,
+            InboundLedgersBehavior::DropAll,
+            PeerFeature::LedgerReplayEnabled);
+
+        // only the start ledger is here, the start ledger of the task above
+        // must come from the task below
+        auto l = net.server.ledgerMaster.getClosedLedger();
+        uint256 finalHash = l->info().hash;
+        for (int i = 0; i < totalReplay - 1; ++i)
+        {
+            l = net.server.ledgerMaster.getLedgerByHash(l->info().parentHash);
+        }
+        net.client.ledgerMaster.storeLedger(l);
+
+        auto const task = net.client.replayer.replay(
+            InboundLedger::Reason::GENERIC, finalHash, totalReplay);
+        BEAST_EXPECT(task && task->getTaskParameter().totalLedgers_ == 256);
+
+        std::vector<TaskStatus> deltaStatuses(255, TaskStatus::Completed);
+        BEAST_EXPECT(net.client.waitAndCheckStatus(
+            finalHash,
+            256,
+            TaskStatus::Completed,
+            TaskStatus::Completed,
+            deltaStatuses));
+        BEAST_EXPECT(net.client.waitForLedgers(finalHash, totalReplay));
+        BEAST_EXPECT(net.client.countsAsExpected(2, 2, totalReplay - 1));
+        BEAST_EXPECT(
+            net.client.replayer.getCatchUpStats().built == totalReplay - 1);
+
+        // merged into the task with the same finish ledger
+        BEAST_EXPECT(
+            net.client.replayer.replay(
+                InboundLedger::Reason::GENERIC, finalHash, totalReplay) ==
+            task);
+
+        // sweep
+        net.client.replayer.sweep();
+        BEAST_EXPECT(net.client.countsAsExpected(0, 0, 0));
+    }
+
     void
     run() override
     {
@@ -1465,6 +1525,7 @@ struct LedgerReplayer_test : public beast::unit_test::suite
         testSkipListBadReply();
         testLedgerDeltaBadReply();
         testLedgerReplayOverlap();
+        testReplayChained();
     }
 };
 
@@ -1533,6 +1594,7 @@ struct LedgerReplayerTimeout_test : public beast::unit_test::suite
         BEAST_EXPECT(net.client.countsAsExpected(1, 1, totalReplay - 1));
         net.client.replayer.sweep();
         BEAST_EXPECT(net.client.countsAsExpected(0, 0, 0));
+        BEAST_EXPECT(!net.client.replayer.wantsReplayDelta(finalHash));
     }
 
     void
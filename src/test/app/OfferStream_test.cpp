@@ -17,7 +17,9 @@
 */
 //==============================================================================
 
+#include <test/jtx.h>
 #include <xrpld/app/tx/detail/OfferStream.h>
+#include <xrpld/ledger/Sandbox.h>
 #include <xrpl/beast/unit_test.h>
 
 namespace ripple {
@@ -31,10 +33,80 @@ public:
         pass();
     }
 
+    void
+    testBookTipQuality()
+    {
+        testcase("book tip quality");
+
+        using namespace test::jtx;
+
+        Env env(*this);
+        Account const gw{"gateway"};
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+        auto const USD = gw["USD"];
+
+        env.fund(XRP(10000), gw, alice, bob);
+        env.trust(USD(1000), alice, bob);
+        env(pay(gw, bob, USD(500)));
+        env.close();
+
+        Book const book{USD.issue(), xrpIssue()};
+        Book const reverse{xrpIssue(), USD.issue()};
+
+        // bookTipQuality agrees with the first step of a BookTip.
+        auto tipQuality = [&](Book const& b) {
+            auto const view = env.current();
+            auto const expected = [&]() -> std::optional<Quality> {
+                Sandbox sb(&*view, tapNONE);
+                BookTip tip(sb, b);
+                if (!tip.step(env.journal))
+                    return std::nullopt;
+                return tip.quality();
+            }();
+            auto const actual = bookTipQuality(*view, b);
+            BEAST_EXPECT(actual == expected);
+            return actual;
+        };
+
+        BEAST_EXPECT(!tipQuality(book));
+        BEAST_EXPECT(!tipQuality(reverse));
+
+        auto const seq = env.seq(alice);
+        env(offer(alice, USD(30), XRP(100)));
+        env(offer(alice, USD(10), XRP(100)));
+        env(offer(alice, USD(10), XRP(50)));
+        env(offer(alice, USD(10), XRP(100)));
+
+        BEAST_EXPECT(
+            tipQuality(book) == Quality(Amounts(USD(10), XRP(100))));
+        BEAST_EXPECT(!tipQuality(reverse));
+
+        // The best directory holds two offers.
+        env(offer_cancel(alice, seq + 1));
+        BEAST_EXPECT(
+            tipQuality(book) == Quality(Amounts(USD(10), XRP(100))));
+        env(offer_cancel(alice, seq + 3));
+        BEAST_EXPECT(tipQuality(book) == Quality(Amounts(USD(10), XRP(50))));
+        env.close();
+        BEAST_EXPECT(tipQuality(book) == Quality(Amounts(USD(10), XRP(50))));
+
+        env(offer(bob, XRP(100), USD(10)));
+        BEAST_EXPECT(
+            tipQuality(reverse) == Quality(Amounts(XRP(100), USD(10))));
+
+        env(offer_cancel(alice, seq + 2));
+        BEAST_EXPECT(
+            tipQuality(book) == Quality(Amounts(USD(30), XRP(100))));
+        env(offer_cancel(alice, seq));
+        BEAST_EXPECT(!tipQuality(book));
+    }
+
     void
     run() override
     {
         test();
+        testBookTipQuality();
     }
 };
 
@@ -18,6 +18,7 @@
 //==============================================================================
 
 #include <test/jtx.h>
+#include <test/jtx/WSClient.h>
 #include <test/jtx/envconfig.h>
 #include <xrpld/app/paths/AccountCurrencies.h>
 #include <xrpld/core/JobQueue.h>
@@ -91,6 +92,57 @@ class Path_test : public beast::unit_test::suite
         }));
     }
 
+protected:
+    jtx::Env
+    pathTestEnv(int rankThreads)
+    {
+        using namespace jtx;
+        return Env(*this, envconfig([rankThreads](std::unique_ptr<Config> cfg) {
+            cfg->PATH_SEARCH_OLD = 7;
+            cfg->PATH_SEARCH = 7;
+            cfg->PATH_SEARCH_MAX = 10;
+            cfg->PATH_RANK_THREADS = rankThreads;
+            // A standalone server runs its jobs on one thread otherwise
+            cfg->FORCE_MULTI_THREAD = true;
+            cfg->WORKERS = rankThreads;
+            return cfg;
+        }));
+    }
+
+    // Alice can pay bob through each of `gateways` gateways, through a
+    // rippling account, and through a USD/EUR order book at several
+    // qualities, which gives the path search many candidates to rank.
+    void
+    multiGatewayFixture(jtx::Env& env, int gateways)
+    {
+        using namespace jtx;
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+        Account const dan{"dan"};
+        Account const market{"market"};
+        env.fund(XRP(100000), alice, bob, dan, market);
+        env.close();
+
+        for (int i = 0; i < gateways; ++i)
+        {
+            Account const gw{"gateway" + std::to_string(i)};
+            env.fund(XRP(10000), gw);
+            env.close();
+            env.trust(gw["USD"](1000), alice, bob, market);
+            env.trust(gw["EUR"](1000), alice, market);
+            env(pay(gw, alice, gw["USD"](100 + i)));
+            env(pay(gw, alice, gw["EUR"](100)));
+            env(pay(gw, market, gw["USD"](500)));
+            for (int q = 1; q <= 3; ++q)
+                env(offer(market, gw["EUR"](10 * q), gw["USD"](10)));
+            env.close();
+        }
+        env.trust(alice["USD"](800), dan);
+        env.trust(dan["USD"](800), alice, bob);
+        env(pay(dan, alice, dan["USD"](100)));
+        env.close();
+    }
+
 public:
     class gate
     {
@@ -1345,6 +1397,120 @@ public:
         test("no ripple -> no ripple", false, false, false);
     }
 
+    void
+    path_rank_threads()
+    {
+        testcase("path ranking is independent of thread count");
+        using namespace jtx;
+
+        auto search = [this](int rankThreads) {
+            Env env = pathTestEnv(rankThreads);
+            multiGatewayFixture(env, 6);
+            return find_paths(env, "alice", "bob", Account("bob")["USD"](25));
+        };
+
+        auto const [serialPaths, serialSrc, serialDst] = search(1);
+        BEAST_EXPECT(!serialPaths.empty());
+        for (int const threads : {2, 4, 8})
+        {
+            auto const [paths, src, dst] = search(threads);
+            BEAST_EXPECT(
+                paths.getJson(JsonOptions::none) ==
+                serialPaths.getJson(JsonOptions::none));
+            BEAST_EXPECT(src == serialSrc);
+            BEAST_EXPECT(dst == serialDst);
+        }
+    }
+
+    void
+    path_find_subscriptions()
+    {
+        testcase("path_find subscriptions updated by several threads");
+        using namespace jtx;
+        using namespace std::chrono_literals;
+
+        Env env(*this, envconfig([](std::unique_ptr<Config> cfg) {
+            cfg->PATH_UPDATE_THREADS = 4;
+            cfg->FORCE_MULTI_THREAD = true;
+            cfg->WORKERS = 4;
+            return cfg;
+        }));
+        auto const gw = Account("gateway");
+        auto const USD = gw["USD"];
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+        Account const carol{"carol"};
+        env.fund(XRP(10000), alice, bob, carol, gw);
+        env.close();
+        env.trust(USD(1000), alice, bob, carol);
+        env(pay(gw, alice, USD(100)));
+        env(pay(gw, carol, USD(100)));
+        env.close();
+
+        // The first two subscriptions have the same source account and
+        // currency, so they are updated by the same thread.
+        std::vector<std::pair<Account, Account>> const subscriptions{
+            {alice, bob}, {alice, carol}, {carol, bob}, {carol, alice}};
+        std::vector<std::unique_ptr<WSClient>> clients;
+        for (auto const& [src, dst] : subscriptions)
+        {
+            auto wsc = makeWSClient(env.app().config());
+            Json::Value request;
+            request[jss::subcommand] = "create";
+            request[jss::source_account] = src.human();
+            request[jss::destination_account] = dst.human();
+            request[jss::destination_amount] =
+                dst["USD"](5).value().getJson(JsonOptions::none);
+            auto const jr = wsc->invoke("path_find", request)[jss::result];
+            BEAST_EXPECT(jr.isMember(jss::alternatives));
+            clients.push_back(std::move(wsc));
+        }
+
+        env.close();
+        for (auto const& wsc : clients)
+        {
+            auto const update = wsc->findMsg(5s, [](Json::Value const& jv) {
+                return jv[jss::type] == "path_find" &&
+                    jv[jss::full_reply] == true;
+            });
+            if (BEAST_EXPECT(update))
+                BEAST_EXPECT((*update)[jss::alternatives].size() == 1);
+        }
+    }
+
+    void
+    ripple_path_find_websocket()
+    {
+        testcase("ripple_path_find over websocket");
+        using namespace jtx;
+        Env env = pathTestEnv();
+        auto const gw = Account("gateway");
+        auto const USD = gw["USD"];
+        env.fund(XRP(10000), "alice", "bob", gw);
+        env.trust(USD(600), "alice");
+        env.trust(USD(700), "bob");
+        env(pay(gw, "alice", USD(70)));
+        env.close();
+
+        // Without a ledger, a websocket request has no Coro to block, so
+        // the handler leaves the wait for the path-finding job to the
+        // websocket task.
+        auto wsc = makeWSClient(env.app().config());
+        Json::Value params;
+        params[jss::source_account] = Account("alice").human();
+        params[jss::destination_account] = Account("bob").human();
+        params[jss::destination_amount] =
+            USD(5).value().getJson(JsonOptions::none);
+        auto const jr = wsc->invoke("ripple_path_find", params)[jss::result];
+        BEAST_EXPECT(!jr.isMember(jss::error));
+        BEAST_EXPECT(jr[jss::alternatives].size() == 1);
+
+        // It finds the same paths as a request run on a Coro
+        auto const expected =
+            find_paths_request(env, "alice", "bob", USD(5));
+        BEAST_EXPECT(jr[jss::alternatives] == expected[jss::alternatives]);
+    }
+
     void
     run() override
     {
@@ -1381,10 +1547,53 @@ public:
         path_find_04();
         path_find_05();
         path_find_06();
+        path_rank_threads();
+        path_find_subscriptions();
+        ripple_path_find_websocket();
+    }
+};
+
+// Measures how long a ripple_path_find with many candidate paths takes when
+// the candidates are ranked on one thread and on several.
+class PathRankBench_test : public Path_test
+{
+    void
+    reportSearchTime(int rankThreads, int gateways)
+    {
+        using namespace jtx;
+        using clock = std::chrono::steady_clock;
+
+        Env env = pathTestEnv(rankThreads);
+        multiGatewayFixture(env, gateways);
+
+        int const iterations = 20;
+        auto const start = clock::now();
+        for (int i = 0; i < iterations; ++i)
+            find_paths(env, "alice", "bob", Account("bob")["USD"](25));
+        auto const elapsed = std::chrono::duration_cast<
+            std::chrono::microseconds>(clock::now() - start);
+
+        log << gateways << " gateways, " << rankThreads
+            << " threads: " << elapsed.count() / iterations
+            << "us per search" << std::endl;
+    }
+
+public:
+    void
+    run() override
+    {
+        testcase("path ranking");
+        for (int const gateways : {4, 16})
+        {
+            for (int const threads : {1, 2, 4, 8})
+                reportSearchTime(threads, gateways);
+        }
+        pass();
     }
 };
 
 BEAST_DEFINE_TESTSUITE(Path, app, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(PathRankBench, app, ripple);
 
 }  // namespace test
 }  // namespace ripple
@@ -0,0 +1,619 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <test/jtx.h>
+#include <test/jtx/AMM.h>
+#include <test/unit_test/SuiteArgs.h>
+#include <xrpld/app/ledger/Ledger.h>
+#include <xrpld/app/ledger/LedgerMaster.h>
+#include <xrpld/app/paths/AMMLiquidity.h>
+#include <xrpld/app/paths/AMMOffer.h>
+#include <xrpld/app/tx/apply.h>
+#include <xrpld/ledger/OpenView.h>
+#include <xrpl/beast/unit_test.h>
+#include <xrpl/json/to_string.h>
+#include <xrpl/protocol/jss.h>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace ripple {
+namespace test {
+
+/** Measures the payment engine applying payments and offers.
+
+    Each scenario builds a ledger with jtx::Env, then times the apply of
+    each transaction against the last closed ledger, counting the reads
+    which reach that ledger. The AMM offer scenarios instead time the
+    generation of AMM offers alone. One JSON object per scenario is
+    written to the log, for regression tracking.
+
+    Arguments, comma separated, all optional:
+        depth=<offers in each order book>
+        hops=<order books, or trust lines, along a path>
+        txs=<transactions timed in each scenario>
+        width=<offers each transaction consumes from a book>
+
+    e.g. --unittest=PaymentEngineBench --unittest-arg=depth=1000,txs=100
+*/
+class PaymentEngineBench_test : public beast::unit_test::suite
+{
+    // Forwards to a ledger, counting the reads which reach it.
+    class CountingView : public ReadView
+    {
+    private:
+        ReadView const& base_;
+
+    public:
+        std::size_t mutable reads = 0;
+
+        explicit CountingView(ReadView const& base) : base_(base)
+        {
+        }
+
+        LedgerInfo const&
+        info() const override
+        {
+            return base_.info();
+        }
+
+        bool
+        open() const override
+        {
+            return base_.open();
+        }
+
+        Fees const&
+        fees() const override
+        {
+            return base_.fees();
+        }
+
+        Rules const&
+        rules() const override
+        {
+            return base_.rules();
+        }
+
+        bool
+        exists(Keylet const& k) const override
+        {
+            ++reads;
+            return base_.exists(k);
+        }
+
+        std::optional<key_type>
+        succ(
+            key_type const& key,
+            std::optional<key_type> const& last = std::nullopt) const override
+        {
+            ++reads;
+            return base_.succ(key, last);
+        }
+
+        std::shared_ptr<SLE const>
+        read(Keylet const& k) const override
+        {
+            ++reads;
+            return base_.read(k);
+        }
+
+        std::unique_ptr<sles_type::iter_base>
+        slesBegin() const override
+        {
+            return base_.slesBegin();
+        }
+
+        std::unique_ptr<sles_type::iter_base>
+        slesEnd() const override
+        {
+            return base_.slesEnd();
+        }
+
+        std::unique_ptr<sles_type::iter_base>
+        slesUpperBound(key_type const& key) const override
+        {
+            return base_.slesUpperBound(key);
+        }
+
+        std::unique_ptr<txs_type::iter_base>
+        txsBegin() const override
+        {
+            return base_.txsBegin();
+        }
+
+        std::unique_ptr<txs_type::iter_base>
+        txsEnd() const override
+        {
+            return base_.txsEnd();
+        }
+
+        bool
+        txExists(key_type const& key) const override
+        {
+            return base_.txExists(key);
+        }
+
+        tx_type
+        txRead(key_type const& key) const override
+        {
+            return base_.txRead(key);
+        }
+    };
+
+    struct Params
+    {
+        int depth = 500;
+        int hops = 3;
+        int txs = 50;
+        int width = 5;
+    };
+
+    struct Sample
+    {
+        std::chrono::nanoseconds elapsed;
+        std::size_t reads;
+    };
+
+    Params
+    parseArgs()
+    {
+        Params p;
+        SuiteArgs args(arg());
+        args.get("depth", p.depth);
+        args.get("hops", p.hops);
+        args.get("txs", p.txs);
+        args.get("width", p.width);
+        args.done();
+
+        // Every timed transaction must find offers left to consume.
+        if (p.depth < p.width * (p.txs + 1))
+        {
+            p.depth = p.width * (p.txs + 1);
+            log << "depth raised to " << p.depth << std::endl;
+        }
+        return p;
+    }
+
+    // Applies the transaction to a fresh open view over the last closed
+    // ledger, as the open ledger would, timing only the apply. Then the
+    // transaction is submitted and the ledger closed, so that the next
+    // one starts from the state this one left.
+    Sample
+    measure(jtx::Env& env, jtx::JTx const& jt)
+    {
+        using clock = std::chrono::steady_clock;
+
+        auto const closed = env.app().getLedgerMaster().getClosedLedger();
+        CachedLedger const cached(closed, env.app().cachedSLEs());
+        CountingView const counting(cached);
+        OpenView view(open_ledger, &counting, env.current()->rules());
+
+        auto const start = clock::now();
+        auto const [ter, applied] =
+            ripple::apply(env.app(), view, *jt.stx, tapNONE, env.journal);
+        auto const elapsed = clock::now() - start;
+        BEAST_EXPECT(ter == tesSUCCESS && applied);
+
+        env.submit(jt);
+        env.close();
+        return {elapsed, counting.reads};
+    }
+
+    void
+    report(
+        std::string const& scenario,
+        Params const& p,
+        std::vector<Sample> samples)
+    {
+        if (samples.empty())
+            return;
+
+        std::sort(
+            samples.begin(), samples.end(), [](auto const& a, auto const& b) {
+                return a.elapsed < b.elapsed;
+            });
+
+        auto micros = [](std::chrono::nanoseconds d) {
+            return static_cast<double>(d.count()) / 1000;
+        };
+        std::chrono::nanoseconds total{0};
+        std::size_t reads = 0;
+        for (auto const& s : samples)
+        {
+            total += s.elapsed;
+            reads += s.reads;
+        }
+        auto const n = samples.size();
+
+        Json::Value jv(Json::objectValue);
+        jv["scenario"] = scenario;
+        jv["depth"] = p.depth;
+        jv["hops"] = p.hops;
+        jv["width"] = p.width;
+        jv["txs"] = static_cast<Json::UInt>(n);
+        jv["mean_us"] = micros(total) / n;
+        jv["p50_us"] = micros(samples[n / 2].elapsed);
+        jv["p90_us"] = micros(samples[n * 9 / 10].elapsed);
+        jv["max_us"] = micros(samples.back().elapsed);
+        jv["reads_per_tx"] = static_cast<double>(reads) / n;
+        log << to_string(jv) << std::endl;
+    }
+
+    // A book path element, for the paths which jtx::path can not build
+    // from a run-time list.
+    static Json::Value
+    bookElement(jtx::IOU const& iou)
+    {
+        Json::Value jv(Json::objectValue);
+        jv[jss::currency] = to_string(iou.currency);
+        jv[jss::issuer] = toBase58(iou.account.id());
+        return jv;
+    }
+
+    static Json::Value
+    accountElement(jtx::Account const& account)
+    {
+        Json::Value jv(Json::objectValue);
+        jv[jss::account] = account.human();
+        return jv;
+    }
+
+    static Json::Value
+    singlePath(Json::Value const& elements)
+    {
+        Json::Value paths(Json::arrayValue);
+        paths.append(elements);
+        return paths;
+    }
+
+    // Makers, funded with every currency, each placing its share of depth
+    // offers of `out` for `in`, at slowly worsening quality.
+    static std::vector<jtx::Account>
+    makers(jtx::Env& env, jtx::Account const& gw, std::vector<jtx::IOU> ious)
+    {
+        using namespace jtx;
+
+        std::vector<Account> result;
+        for (int i = 0; i < 10; ++i)
+            result.emplace_back("maker" + std::to_string(i));
+
+        for (auto const& maker : result)
+        {
+            env.fund(XRP(1000000), maker);
+            for (auto const& iou : ious)
+            {
+                env(trust(maker, iou(1000000000)));
+                env(pay(gw, maker, iou(1000000)));
+            }
+        }
+        env.close();
+        return result;
+    }
+
+    template <class In, class Out>
+    static void
+    fillBook(
+        jtx::Env& env,
+        std::vector<jtx::Account> const& makers,
+        int depth,
+        In const& in,
+        Out const& out)
+    {
+        for (int i = 0; i < depth; ++i)
+        {
+            env(jtx::offer(makers[i % makers.size()], in(i), out));
+            if (i % 256 == 255)
+                env.close();
+        }
+        env.close();
+    }
+
+    void
+    benchBook(Params const& p)
+    {
+        testcase("payment through one book");
+
+        using namespace jtx;
+
+        Env env(*this);
+        Account const gw{"gateway"};
+        Account const alice{"alice"};
+        Account const carol{"carol"};
+        auto const USD = gw["USD"];
+
+        env.fund(XRP(10000000), gw, alice, carol);
+        env.trust(USD(1000000000), carol);
+        env.close();
+
+        auto const m = makers(env, gw, {USD});
+        fillBook(
+            env, m, p.depth, [](int i) { return XRP(100 + i); }, USD(10));
+
+        std::vector<Sample> samples;
+        for (int i = 0; i < p.txs; ++i)
+            samples.push_back(measure(
+                env,
+                env.jt(
+                    pay(alice, carol, USD(10 * p.width - 5)),
+                    sendmax(XRP(1000000)),
+                    path(~USD))));
+        report("book", p, std::move(samples));
+    }
+
+    void
+    benchOfferCrossing(Params const& p)
+    {
+        testcase("offer crossing one book");
+
+        using namespace jtx;
+
+        Env env(*this);
+        Account const gw{"gateway"};
+        Account const alice{"alice"};
+        auto const USD = gw["USD"];
+
+        env.fund(XRP(10000000), gw, alice);
+        env.trust(USD(1000000000), alice);
+        env.close();
+
+        auto const m = makers(env, gw, {USD});
+        fillBook(
+            env, m, p.depth, [](int i) { return XRP(100 + i); }, USD(10));
+
+        // Generous enough to cross every offer in the book, and
+        // immediate-or-cancel so that no part of it is left on the book.
+        std::vector<Sample> samples;
+        for (int i = 0; i < p.txs; ++i)
+            samples.push_back(measure(
+                env,
+                env.jt(
+                    offer(
+                        alice,
+                        USD(10 * p.width - 5),
+                        XRP(p.width * (100 + p.depth))),
+                    txflags(tfImmediateOrCancel))));
+        report("offer_crossing", p, std::move(samples));
+    }
+
+    void
+    benchMultiBook(Params const& p)
+    {
+        testcase("payment through several books");
+
+        using namespace jtx;
+
+        Env env(*this);
+        Account const gw{"gateway"};
+        Account const alice{"alice"};
+        Account const carol{"carol"};
+
+        std::vector<IOU> ious;
+        for (int i = 0; i < p.hops; ++i)
+        {
+            std::string code{"C"};
+            code += static_cast<char>('A' + i / 26);
+            code += static_cast<char>('A' + i % 26);
+            ious.push_back(gw[code]);
+        }
+
+        env.fund(XRP(10000000), gw, alice, carol);
+        env.trust(ious.back()(1000000000), carol);
+        env.close();
+
+        auto const m = makers(env, gw, ious);
+        fillBook(
+            env,
+            m,
+            p.depth,
+            [](int i) { return XRP(100 + i); },
+            ious.front()(10));
+        for (std::size_t i = 1; i < ious.size(); ++i)
+        {
+            auto const& in = ious[i - 1];
+            fillBook(
+                env,
+                m,
+                p.depth,
+                [&in](int j) { return in(10 + j * 0.01); },
+                ious[i](10));
+        }
+
+        Json::Value elements(Json::arrayValue);
+        for (auto const& iou : ious)
+            elements.append(bookElement(iou));
+        auto const paths = singlePath(elements);
+
+        std::vector<Sample> samples;
+        for (int i = 0; i < p.txs; ++i)
+            samples.push_back(measure(
+                env,
+                env.jt(
+                    pay(alice, carol, ious.back()(10 * p.width - 5)),
+                    sendmax(XRP(10000000)),
+                    json(jss::Paths, paths))));
+        report("multi_book", p, std::move(samples));
+    }
+
+    void
+    benchRippling(Params const& p)
+    {
+        testcase("payment rippling through accounts");
+
+        using namespace jtx;
+
+        Env env(*this);
+
+        std::vector<Account> chain;
+        for (int i = 0; i <= p.hops; ++i)
+        {
+            chain.emplace_back("hop" + std::to_string(i));
+            env.fund(XRP(10000), chain.back());
+        }
+        env.close();
+        for (int i = 1; i <= p.hops; ++i)
+            env(trust(chain[i], chain[i - 1]["USD"](1000000000)));
+        env.close();
+
+        Json::Value elements(Json::arrayValue);
+        for (int i = 1; i < p.hops; ++i)
+            elements.append(accountElement(chain[i]));
+        auto const paths = singlePath(elements);
+
+        auto const& src = chain.front();
+        auto const& dst = chain.back();
+
+        std::vector<Sample> samples;
+        for (int i = 0; i < p.txs; ++i)
+        {
+            auto jt = p.hops > 1
+                ? env.jt(
+                      pay(src, dst, dst["USD"](10)), json(jss::Paths, paths))
+                : env.jt(pay(src, dst, dst["USD"](10)));
+            samples.push_back(measure(env, jt));
+        }
+        report("rippling", p, std::move(samples));
+    }
+
+    void
+    benchAMM(Params const& p)
+    {
+        testcase("payment through an AMM pool and a book");
+
+        using namespace jtx;
+
+        Env env(*this);
+        Account const gw{"gateway"};
+        Account const alice{"alice"};
+        Account const carol{"carol"};
+        auto const USD = gw["USD"];
+
+        env.fund(XRP(100000000), gw, alice, carol);
+        env.trust(USD(1000000000), carol);
+        env.close();
+
+        // The pool's quality straddles the book's, so the engine moves
+        // between the two.
+        AMM const amm(env, gw, XRP(10000000), USD(1000000));
+
+        auto const m = makers(env, gw, {USD});
+        fillBook(
+            env, m, p.depth, [](int i) { return XRP(100 + i); }, USD(10));
+
+        std::vector<Sample> samples;
+        for (int i = 0; i < p.txs; ++i)
+            samples.push_back(measure(
+                env,
+                env.jt(
+                    pay(alice, carol, USD(10 * p.width - 5)),
+                    sendmax(XRP(1000000)),
+                    path(~USD))));
+        report("amm", p, std::move(samples));
+    }
+
+    // Times AMMLiquidity::getOffer on its own, as BookStep calls it for
+    // each offer it takes from the pool.
+    void
+    benchAMMOffer(Params const& p)
+    {
+        testcase("AMM offer generation");
+
+        using namespace jtx;
+        using clock = std::chrono::steady_clock;
+
+        Env env(*this);
+        Account const gw{"gateway"};
+        auto const USD = gw["USD"];
+        auto const EUR = gw["EUR"];
+
+        env.fund(XRP(100000000), gw);
+        env.close();
+        AMM const amm(env, gw, USD(1000000), EUR(1000000));
+
+        auto const closed = env.app().getLedgerMaster().getClosedLedger();
+        CachedLedger const cached(closed, env.app().cachedSLEs());
+        CountingView const counting(cached);
+        auto const calls = 100 * p.txs;
+
+        auto run = [&](std::string const& scenario,
+                       bool multiPath,
+                       std::optional<Quality> const& clobQuality) {
+            AMMContext context(gw.id(), multiPath);
+            AMMLiquidity<IOUAmount, IOUAmount> const liquidity(
+                counting,
+                amm.ammAccount(),
+                0,
+                USD.issue(),
+                EUR.issue(),
+                context,
+                env.journal);
+            counting.reads = 0;
+
+            int offers = 0;
+            auto const start = clock::now();
+            for (int i = 0; i < calls; ++i)
+            {
+                if (liquidity.getOffer(counting, clobQuality))
+                    ++offers;
+            }
+            auto const elapsed = clock::now() - start;
+            BEAST_EXPECT(offers == calls);
+
+            Json::Value jv(Json::objectValue);
+            jv["scenario"] = scenario;
+            jv["calls"] = calls;
+            jv["mean_ns"] =
+                static_cast<double>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        elapsed)
+                        .count()) /
+                calls;
+            jv["reads_per_call"] =
+                static_cast<double>(counting.reads) / calls;
+            log << to_string(jv) << std::endl;
+        };
+
+        run("amm_offer_single_path", false, std::nullopt);
+        run("amm_offer_clob_quality",
+            false,
+            Quality{Amounts{USD(110).value(), EUR(100).value()}});
+        run("amm_offer_multi_path", true, std::nullopt);
+    }
+
+public:
+    void
+    run() override
+    {
+        auto const p = parseArgs();
+
+        benchBook(p);
+        benchOfferCrossing(p);
+        benchMultiBook(p);
+        benchRippling(p);
+        benchAMM(p);
+        benchAMMOffer(p);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(PaymentEngineBench, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
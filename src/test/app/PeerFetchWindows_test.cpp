@@ -0,0 +1,444 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <test/unit_test/SuiteArgs.h>
+#include <xrpld/app/ledger/detail/PeerFetchWindows.h>
+#include <xrpl/beast/clock/manual_clock.h>
+#include <xrpl/beast/unit_test.h>
+
+#include <iomanip>
+#include <map>
+#include <queue>
+#include <set>
+
+namespace ripple {
+namespace test {
+
+namespace {
+
+using namespace std::chrono_literals;
+using clock_type = beast::manual_clock<std::chrono::steady_clock>;
+using Node = PeerFetchWindows::Node;
+
+// The node of a 16-ary tree at the given depth and position among the
+// nodes of that depth, in the order of their node IDs.
+Node
+makeNode(unsigned int depth, std::uint64_t index)
+{
+    uint256 key;
+    for (unsigned int i = 0; i < depth; ++i)
+    {
+        auto const nibble = (index >> (4 * (depth - 1 - i))) & 0xF;
+        key.data()[i / 2] |= (i % 2) ? nibble : nibble << 4;
+    }
+    // The key is zero past the path, so its last byte can tell the depth
+    uint256 hash = key;
+    hash.data()[hash.size() - 1] = depth + 1;
+    return {SHAMapNodeID::createID(depth, key), hash};
+}
+
+unsigned int
+branchOf(Node const& node)
+{
+    return *node.first.getNodeID().begin() >> 4;
+}
+
+}  // namespace
+
+class PeerFetchWindows_test : public beast::unit_test::suite
+{
+    void
+    testAssign()
+    {
+        testcase("assign");
+
+        clock_type clock;
+        PeerFetchWindows windows(clock, 3s);
+
+        // Three nodes in each subtree
+        std::vector<Node> nodes;
+        for (std::uint64_t i = 0; i < 48; ++i)
+            nodes.push_back(makeNode(2, i * 16 / 3));
+
+        std::vector<Peer::id_t> const peers{1, 2, 3};
+        BEAST_EXPECT(
+            windows.capacity(peers) == 3 * PeerFetchWindows::initialWindow);
+
+        auto const assigned = windows.assign(nodes, peers);
+        BEAST_EXPECT(assigned.size() == 3);
+
+        // Every node is asked of exactly one peer, with whole subtrees
+        std::set<uint256> seen;
+        std::map<unsigned int, Peer::id_t> owner;
+        for (auto const& [peer, list] : assigned)
+        {
+            for (auto const& node : list)
+            {
+                BEAST_EXPECT(seen.insert(node.second).second);
+                auto const [it, inserted] =
+                    owner.emplace(branchOf(node), peer);
+                BEAST_EXPECT(inserted || it->second == peer);
+            }
+        }
+        BEAST_EXPECT(seen.size() == nodes.size());
+        BEAST_EXPECT(windows.outstanding() == nodes.size());
+
+        // Busy peers are not asked again
+        BEAST_EXPECT(windows.capacity(peers) == 0);
+        BEAST_EXPECT(windows.assign(nodes, peers).empty());
+
+        // A peer which answered is not asked for nodes other peers have
+        auto const& first = assigned.front();
+        BEAST_EXPECT(windows.onReply(
+            first.first,
+            first.second.front().first,
+            first.second.size()));
+        BEAST_EXPECT(
+            windows.outstanding() == nodes.size() - first.second.size());
+        auto const again = windows.assign(nodes, peers);
+        if (BEAST_EXPECT(again.size() == 1))
+        {
+            BEAST_EXPECT(again.front().first == first.first);
+            BEAST_EXPECT(again.front().second.size() == first.second.size());
+        }
+
+        // Giving up on everything frees all the nodes
+        windows.reset();
+        BEAST_EXPECT(windows.outstanding() == 0);
+        BEAST_EXPECT(windows.assign(nodes, peers).size() == 3);
+    }
+
+    void
+    testWindow()
+    {
+        testcase("window");
+
+        clock_type clock;
+        PeerFetchWindows windows(clock, 3s);
+
+        std::vector<Node> nodes;
+        for (std::uint64_t i = 0; i < 4096; ++i)
+            nodes.push_back(makeNode(3, i));
+
+        Peer::id_t const peer = 7;
+        // The first node of the last request
+        SHAMapNodeID first;
+        auto const request = [&]() -> std::size_t {
+            auto const assigned = windows.assign(nodes, {peer});
+            if (assigned.empty())
+                return 0;
+            first = assigned.front().second.front().first;
+            return assigned.front().second.size();
+        };
+        auto const reply = [&](std::size_t received) {
+            return windows.onReply(peer, first, received);
+        };
+
+        // Full and fast answers double the window
+        auto window = PeerFetchWindows::initialWindow;
+        BEAST_EXPECT(request() == window);
+        clock.advance(20ms);
+        BEAST_EXPECT(reply(window));
+        BEAST_EXPECT(windows.window(peer) == 2 * window);
+        BEAST_EXPECT(windows.roundTrip(peer) == 20ms);
+
+        while (windows.window(peer) < PeerFetchWindows::maxWindow)
+        {
+            window = request();
+            clock.advance(20ms);
+            reply(window);
+        }
+        BEAST_EXPECT(request() == PeerFetchWindows::maxWindow);
+        clock.advance(20ms);
+        reply(PeerFetchWindows::maxWindow);
+        BEAST_EXPECT(windows.window(peer) == PeerFetchWindows::maxWindow);
+
+        // A slow answer sizes the window to the rate the peer delivers
+        BEAST_EXPECT(request() == PeerFetchWindows::maxWindow);
+        clock.advance(80ms);
+        reply(PeerFetchWindows::maxWindow);
+        BEAST_EXPECT(windows.window(peer) == PeerFetchWindows::maxWindow / 2);
+
+        // A short answer halves it
+        window = request();
+        clock.advance(20ms);
+        reply(window / 2);
+        BEAST_EXPECT(windows.window(peer) == window / 2);
+
+        // An unanswered request times out after a few round trips, and its
+        // nodes may be asked of another peer
+        window = request();
+        BEAST_EXPECT(window == windows.window(peer));
+        clock.advance(50ms);
+        BEAST_EXPECT(windows.expire() == 0);
+        clock.advance(1s);
+        BEAST_EXPECT(windows.expire() == window);
+        BEAST_EXPECT(windows.window(peer) == window / 2);
+        BEAST_EXPECT(windows.outstanding() == 0);
+
+        // A late answer is ignored
+        BEAST_EXPECT(!reply(window));
+        BEAST_EXPECT(windows.window(peer) == window / 2);
+
+        // A late answer is not credited to a newer request
+        std::vector<Node> others;
+        for (std::uint64_t i = 0; i < 4096; ++i)
+            others.push_back(makeNode(4, i));
+        auto const roundTrip = windows.roundTrip(peer);
+        window = request();
+        clock.advance(1s);
+        BEAST_EXPECT(windows.expire() == window);
+        auto const late = first;
+        auto const assigned = windows.assign(others, {peer});
+        if (BEAST_EXPECT(assigned.size() == 1))
+        {
+            auto const& asked = assigned.front().second;
+            clock.advance(1ms);
+            BEAST_EXPECT(!windows.onReply(peer, late, window));
+            BEAST_EXPECT(windows.outstanding() == asked.size());
+            BEAST_EXPECT(windows.roundTrip(peer) == roundTrip);
+            clock.advance(20ms);
+            BEAST_EXPECT(
+                windows.onReply(peer, asked.front().first, asked.size()));
+            BEAST_EXPECT(windows.outstanding() == 0);
+        }
+
+        // An answer which may be to a request given up on is not timed
+        window = request();
+        auto const expired = first;
+        clock.advance(1s);
+        BEAST_EXPECT(windows.expire() == window);
+        window = request();
+        BEAST_EXPECT(first == expired);
+        auto const before = windows.roundTrip(peer);
+        clock.advance(1ms);
+        BEAST_EXPECT(reply(window));
+        BEAST_EXPECT(windows.outstanding() == 0);
+        BEAST_EXPECT(windows.roundTrip(peer) == before);
+
+        // The window never drops below the minimum
+        for (int i = 0; i < 10; ++i)
+        {
+            request();
+            windows.reset();
+        }
+        BEAST_EXPECT(windows.window(peer) == PeerFetchWindows::minWindow);
+    }
+
+public:
+    void
+    run() override
+    {
+        testAssign();
+        testWindow();
+    }
+};
+
+/** Simulates acquiring a map from peers with the given round trip time.
+
+    The map is a full 16-ary tree. Each peer answers its requests in order,
+    delivering a fixed number of nodes per second, and every request is
+    answered. Node requests with the fixed window the acquisition used to
+    have are compared with PeerFetchWindows.
+
+    Parameters, all optional: depth (of the tree, default 4), rate (nodes per
+    second each peer delivers, default 20000).
+*/
+class PeerFetchWindowsSim_test : public beast::unit_test::suite
+{
+    // The number of nodes asked of a peer at once, before adaptive windows
+    static constexpr std::size_t fixedWindow = 128;
+
+    struct Reply
+    {
+        clock_type::time_point at;
+        Peer::id_t peer;
+        std::vector<Node> nodes;
+
+        bool
+        operator>(Reply const& other) const
+        {
+            return at > other.at;
+        }
+    };
+
+    // Virtual time to acquire the whole tree
+    std::chrono::milliseconds
+    simulate(
+        bool adaptive,
+        std::size_t peerCount,
+        std::chrono::milliseconds roundTrip,
+        unsigned int depth,
+        std::size_t rate)
+    {
+        clock_type clock;
+        PeerFetchWindows windows(clock, 3s);
+
+        std::vector<Peer::id_t> peers;
+        for (std::size_t i = 0; i < peerCount; ++i)
+            peers.push_back(i + 1);
+        std::vector<clock_type::time_point> busyUntil(peerCount + 1);
+
+        // The nodes known to be missing, in the order they were found
+        std::map<std::uint64_t, std::pair<unsigned int, std::uint64_t>>
+            missing;
+        hash_map<uint256, std::uint64_t> order;
+        std::uint64_t found = 0;
+        auto const discover = [&](unsigned int d, std::uint64_t index) {
+            order.emplace(makeNode(d, index).second, found);
+            missing.emplace(found++, std::make_pair(d, index));
+        };
+        discover(0, 0);
+
+        // For the fixed window
+        std::set<uint256> inFlight;
+        std::vector<bool> idle(peerCount + 1, true);
+
+        std::priority_queue<Reply, std::vector<Reply>, std::greater<>> replies;
+        auto const send = [&](Peer::id_t peer, std::vector<Node> nodes) {
+            auto const start =
+                std::max(clock.now() + roundTrip / 2, busyUntil[peer]);
+            busyUntil[peer] = start +
+                std::chrono::microseconds(nodes.size() * 1000000 / rate);
+            replies.push({busyUntil[peer] + roundTrip / 2, peer, nodes});
+        };
+
+        auto const dispatch = [&]() {
+            if (adaptive)
+            {
+                auto const wanted =
+                    windows.outstanding() + windows.capacity(peers);
+                std::vector<Node> nodes;
+                for (auto it = missing.begin();
+                     it != missing.end() && nodes.size() < wanted;
+                     ++it)
+                    nodes.push_back(
+                        makeNode(it->second.first, it->second.second));
+                for (auto& [peer, assigned] : windows.assign(nodes, peers))
+                    send(peer, std::move(assigned));
+                return;
+            }
+
+            auto it = missing.begin();
+            for (auto const peer : peers)
+            {
+                if (!idle[peer])
+                    continue;
+                std::vector<Node> nodes;
+                for (; it != missing.end() && nodes.size() < fixedWindow;
+                     ++it)
+                {
+                    auto node = makeNode(it->second.first, it->second.second);
+                    if (inFlight.insert(node.second).second)
+                        nodes.push_back(std::move(node));
+                }
+                if (nodes.empty())
+                    break;
+                idle[peer] = false;
+                send(peer, std::move(nodes));
+            }
+        };
+
+        clock_type::time_point done;
+        dispatch();
+        while (!replies.empty())
+        {
+            auto const reply = replies.top();
+            replies.pop();
+            clock.set(reply.at);
+
+            for (auto const& node : reply.nodes)
+            {
+                // A node asked again after a timeout may arrive twice
+                auto const it = missing.find(order.at(node.second));
+                if (it == missing.end())
+                    continue;
+
+                auto const d = node.first.getDepth();
+                auto const index = it->second.second;
+                missing.erase(it);
+                inFlight.erase(node.second);
+                if (d < depth)
+                {
+                    for (std::uint64_t c = 0; c < 16; ++c)
+                        discover(d + 1, index * 16 + c);
+                }
+            }
+
+            if (adaptive)
+                windows.onReply(
+                    reply.peer,
+                    reply.nodes.front().first,
+                    reply.nodes.size());
+            else
+                idle[reply.peer] = true;
+
+            if (missing.empty() && done == clock_type::time_point{})
+                done = clock.now();
+
+            dispatch();
+        }
+
+        BEAST_EXPECT(missing.empty());
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            done.time_since_epoch());
+    }
+
+public:
+    void
+    run() override
+    {
+        unsigned int depth = 4;
+        std::size_t rate = 20000;
+        SuiteArgs args(arg());
+        args.get("depth", depth);
+        args.get("rate", rate);
+        args.done();
+
+        testcase(
+            "depth " + std::to_string(depth) + ", " + std::to_string(rate) +
+            " nodes/s per peer");
+
+        log << std::setw(6) << "peers" << std::setw(8) << "rtt_ms"
+            << std::setw(10) << "fixed_ms" << std::setw(13) << "adaptive_ms"
+            << std::setw(9) << "speedup" << std::endl;
+        for (std::size_t const peerCount : {1, 2, 4, 8})
+        {
+            for (auto const roundTrip : {10ms, 50ms, 200ms})
+            {
+                auto const fixed =
+                    simulate(false, peerCount, roundTrip, depth, rate);
+                auto const adaptive =
+                    simulate(true, peerCount, roundTrip, depth, rate);
+                log << std::setw(6) << peerCount << std::setw(8)
+                    << roundTrip.count() << std::setw(10) << fixed.count()
+                    << std::setw(13) << adaptive.count() << std::setw(9)
+                    << std::fixed << std::setprecision(2)
+                    << double(fixed.count()) / adaptive.count() << std::endl;
+            }
+        }
+        pass();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(PeerFetchWindows, app, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(PeerFetchWindowsSim, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
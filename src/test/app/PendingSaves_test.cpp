@@ -0,0 +1,135 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <test/jtx.h>
+#include <xrpld/app/ledger/LedgerMaster.h>
+#include <xrpld/app/ledger/PendingSaves.h>
+#include <xrpl/beast/unit_test.h>
+#include <algorithm>
+
+namespace ripple {
+namespace test {
+
+class PendingSaves_test : public beast::unit_test::suite
+{
+    // Close `count` ledgers and return them in the order they were closed.
+    static std::vector<std::shared_ptr<Ledger const>>
+    closeLedgers(jtx::Env& env, std::size_t count)
+    {
+        std::vector<std::shared_ptr<Ledger const>> ledgers;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            env.close();
+            ledgers.push_back(env.app().getLedgerMaster().getClosedLedger());
+        }
+        return ledgers;
+    }
+
+    void
+    testBatches()
+    {
+        testcase("batches");
+
+        using namespace jtx;
+        Env env(*this);
+        auto const ledgers = closeLedgers(env, 20);
+
+        PendingSaves saves;
+
+        // Only the first ledger queued asks for a job; the others are
+        // picked up by that job.
+        for (auto it = ledgers.rbegin(); it != ledgers.rend(); ++it)
+        {
+            auto const seq = (*it)->info().seq;
+            BEAST_EXPECT(saves.shouldWork(seq, false));
+            BEAST_EXPECT(
+                saves.enqueue(seq, *it, false) == (*it == ledgers.back()));
+        }
+        BEAST_EXPECT(saves.size() == ledgers.size());
+
+        // Batches are bounded and come out in ascending sequence order,
+        // whatever order the ledgers were queued in.
+        auto batch = saves.dequeue(false, 16);
+        BEAST_EXPECT(batch.size() == 16);
+        for (std::size_t i = 0; i < batch.size(); ++i)
+            BEAST_EXPECT(batch[i] == ledgers[i]);
+
+        batch = saves.dequeue(false, 16);
+        BEAST_EXPECT(batch.size() == 4);
+        for (std::size_t i = 0; i < batch.size(); ++i)
+            BEAST_EXPECT(batch[i] == ledgers[16 + i]);
+
+        // An empty queue ends the job, so the next ledger asks for a new
+        // one.
+        BEAST_EXPECT(saves.dequeue(false, 16).empty());
+        BEAST_EXPECT(saves.enqueue(
+            ledgers.front()->info().seq, ledgers.front(), false));
+    }
+
+    void
+    testPriority()
+    {
+        testcase("current ledgers don't wait for history");
+
+        using namespace jtx;
+        Env env(*this);
+        auto const ledgers = closeLedgers(env, 10);
+        auto const& current = ledgers.back();
+
+        PendingSaves saves;
+
+        // A backfill is being written.
+        for (std::size_t i = 0; i + 1 < ledgers.size(); ++i)
+        {
+            BEAST_EXPECT(
+                saves.enqueue(ledgers[i]->info().seq, ledgers[i], false) ==
+                (i == 0));
+        }
+        BEAST_EXPECT(saves.dequeue(false, 4).size() == 4);
+
+        // A current ledger gets its own job rather than joining the
+        // backlog of history.
+        BEAST_EXPECT(saves.enqueue(current->info().seq, current, true));
+
+        auto batch = saves.dequeue(true, 16);
+        BEAST_EXPECT(batch.size() == 1);
+        BEAST_EXPECT(batch.front() == current);
+        BEAST_EXPECT(saves.dequeue(true, 16).empty());
+
+        // The history job is unaffected and never sees the current ledger.
+        batch = saves.dequeue(false, 16);
+        BEAST_EXPECT(batch.size() == ledgers.size() - 5);
+        BEAST_EXPECT(
+            std::find(batch.begin(), batch.end(), current) == batch.end());
+        BEAST_EXPECT(saves.dequeue(false, 16).empty());
+    }
+
+public:
+    void
+    run() override
+    {
+        testBatches();
+        testPriority();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(PendingSaves, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
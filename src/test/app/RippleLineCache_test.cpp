@@ -0,0 +1,170 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <test/jtx.h>
+#include <xrpld/app/paths/RippleLineCache.h>
+#include <xrpl/beast/unit_test.h>
+
+namespace ripple {
+namespace test {
+
+class RippleLineCache_test : public beast::unit_test::suite
+{
+    // Both caches return the same trust lines, with the same contents, for
+    // every account and direction.
+    void
+    expectSameLines(
+        RippleLineCache& lhs,
+        RippleLineCache& rhs,
+        std::vector<AccountID> const& accounts)
+    {
+        for (auto const& account : accounts)
+        {
+            for (auto const direction :
+                 {LineDirection::outgoing, LineDirection::incoming})
+            {
+                auto const a = lhs.getRippleLines(account, direction);
+                auto const b = rhs.getRippleLines(account, direction);
+                if (!BEAST_EXPECT(!a == !b))
+                    continue;
+                if (!a)
+                    continue;
+                if (!BEAST_EXPECT(a->size() == b->size()))
+                    continue;
+                for (std::size_t i = 0; i < a->size(); ++i)
+                {
+                    auto const& x = (*a)[i];
+                    auto const& y = (*b)[i];
+                    BEAST_EXPECT(x.key() == y.key());
+                    BEAST_EXPECT(x.getBalance() == y.getBalance());
+                    BEAST_EXPECT(x.getLimit() == y.getLimit());
+                    BEAST_EXPECT(x.getLimitPeer() == y.getLimitPeer());
+                    BEAST_EXPECT(x.getNoRipple() == y.getNoRipple());
+                    BEAST_EXPECT(x.getNoRipplePeer() == y.getNoRipplePeer());
+                    BEAST_EXPECT(x.getFreeze() == y.getFreeze());
+                }
+            }
+        }
+    }
+
+    void
+    testCanSeed()
+    {
+        using namespace jtx;
+
+        testcase("can seed");
+
+        Env env(*this);
+        env.close();
+        auto const first = env.closed();
+        env.close();
+        auto const second = env.closed();
+        env.close();
+        auto const third = env.closed();
+
+        RippleLineCache cache(first, env.journal);
+        BEAST_EXPECT(cache.canSeed(*second));
+        BEAST_EXPECT(!cache.canSeed(*first));
+        BEAST_EXPECT(!cache.canSeed(*third));
+        BEAST_EXPECT(!cache.canSeed(*env.current()));
+
+        RippleLineCache openCache(env.current(), env.journal);
+        env.close();
+        BEAST_EXPECT(!openCache.canSeed(*env.closed()));
+    }
+
+    void
+    testConsistency()
+    {
+        using namespace jtx;
+
+        testcase("consistency");
+
+        Env env(*this);
+        Account const gw{"gateway"};
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+        Account const carol{"carol"};
+        Account const dan{"dan"};
+        auto const USD = gw["USD"];
+        auto const EUR = gw["EUR"];
+
+        env.fund(XRP(10000), gw, alice, bob, carol, dan);
+        env.close();
+        env.trust(USD(1000), alice, bob, carol);
+        env.trust(EUR(1000), alice, bob);
+        env(trust(dan, USD(1000)), txflags(tfSetNoRipple));
+        env.close();
+        env(pay(gw, alice, USD(100)));
+        env(pay(gw, bob, EUR(50)));
+        env.close();
+
+        std::vector<AccountID> const accounts{
+            gw.id(), alice.id(), bob.id(), carol.id(), dan.id()};
+
+        auto parent = std::make_shared<RippleLineCache>(
+            env.closed(), env.journal);
+        for (auto const& account : accounts)
+            parent->getRippleLines(account, LineDirection::outgoing);
+        BEAST_EXPECT(parent->getAccountCount() == accounts.size());
+        BEAST_EXPECT(parent->getLineCount() == 12);
+
+        // Change balances and a flag, and create a line. Bob's lines are
+        // untouched.
+        env(pay(alice, carol, USD(10)));
+        env(trust(dan, EUR(1000)));
+        env(trust(carol, USD(1000)), txflags(tfSetNoRipple));
+        env(pay(gw, alice, EUR(5)));
+        env.close();
+
+        auto const ledger = env.closed();
+        if (!BEAST_EXPECT(parent->canSeed(*ledger)))
+            return;
+
+        RippleLineCache seeded(ledger, *parent, env.journal);
+        // Only bob's lines are reused. The gateway is on every changed line.
+        BEAST_EXPECT(seeded.getReusedCount() == 1);
+        BEAST_EXPECT(seeded.getLineCount() == 2);
+
+        RippleLineCache fresh(ledger, env.journal);
+        expectSameLines(seeded, fresh, accounts);
+        BEAST_EXPECT(seeded.getAccountCount() == fresh.getAccountCount());
+        BEAST_EXPECT(seeded.getLineCount() == fresh.getLineCount());
+
+        // Seeding is repeatable over a chain of ledgers.
+        env(pay(gw, bob, USD(7)));
+        env.close();
+        RippleLineCache next(env.closed(), seeded, env.journal);
+        RippleLineCache nextFresh(env.closed(), env.journal);
+        expectSameLines(next, nextFresh, accounts);
+    }
+
+public:
+    void
+    run() override
+    {
+        testCanSeed();
+        testConsistency();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(RippleLineCache, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -23,6 +23,8 @@
 #include <xrpld/app/misc/SHAMapStore.h>
 #include <xrpld/app/rdb/backend/SQLiteDatabase.h>
 #include <xrpld/core/ConfigSections.h>
+#include <xrpld/nodestore/DatabaseRotating.h>
+#include <xrpl/protocol/digest.h>
 #include <xrpl/protocol/jss.h>
 
 namespace ripple {
@@ -49,6 +51,16 @@ class SHAMapStore_test : public beast::unit_test::suite
         return cfg;
     }
 
+    static auto
+    coldTier(std::unique_ptr<Config> cfg)
+    {
+        auto& section = cfg->section(ConfigSection::coldNodeDatabase());
+        section.set("type", "memory");
+        section.set("path", "cold");
+        section.set("hot_ledgers", std::to_string(deleteInterval));
+        return cfg;
+    }
+
     bool
     goodLedger(
         jtx::Env& env,
@@ -518,12 +530,94 @@ public:
         lastRotated = ledgerSeq - 1;
     }
 
+    void
+    testCopyToWritable()
+    {
+        testcase("copy to writable backend");
+        using namespace jtx;
+
+        Env env(*this, envconfig(onlineDelete));
+        auto const db = dynamic_cast<NodeStore::DatabaseRotating*>(
+            &env.app().getNodeStore());
+        if (!BEAST_EXPECT(db))
+            return;
+
+        NodeStore::Batch batch;
+        for (std::uint8_t i = 1; i <= 3; ++i)
+        {
+            Blob data(32, i);
+            auto const hash = sha512Half(makeSlice(data));
+            batch.push_back(NodeObject::createObject(
+                hotACCOUNT_NODE, std::move(data), hash));
+        }
+        BEAST_EXPECT(db->copyToWritable({}) == 0);
+
+        // Only the objects the writable backend lacks are written
+        BEAST_EXPECT(db->copyToWritable({batch.front()}) == 1);
+        BEAST_EXPECT(db->copyToWritable(batch) == batch.size() - 1);
+        BEAST_EXPECT(db->copyToWritable(batch) == 0);
+
+        for (auto const& nodeObject : batch)
+        {
+            auto const fetched = db->fetchNodeObject(nodeObject->getHash());
+            if (BEAST_EXPECT(fetched))
+                BEAST_EXPECT(fetched->getData() == nodeObject->getData());
+        }
+    }
+
+    void
+    testColdTier()
+    {
+        testcase("cold tier");
+        using namespace jtx;
+
+        Env env(*this, envconfig(coldTier));
+        auto& store = env.app().getSHAMapStore();
+        BEAST_EXPECT(!store.advisoryDelete());
+        BEAST_EXPECT(store.clampFetchDepth(1000) == 1000);
+
+        auto ledgerSeq = waitForReady(env);
+        auto const firstRotated = store.getLastRotated();
+
+        env.fund(XRP(10000), noripple("alice"));
+        env.close();
+        auto const early = env.closed()->info();
+        ++ledgerSeq;
+
+        // Change the state in every ledger, so that the early state map
+        // root is not carried over to the new writable backend.
+        for (int rotations = 0; rotations < 3; ++rotations)
+        {
+            for (int i = 0; i < deleteInterval; ++i, ++ledgerSeq)
+            {
+                env.fund(
+                    XRP(10000),
+                    noripple("test" + std::to_string(ledgerSeq)));
+                env.close();
+            }
+            store.rendezvous();
+        }
+        BEAST_EXPECT(store.getLastRotated() > firstRotated + deleteInterval);
+
+        // History is kept, and the rotated out nodes are in the cold tier
+        ledgerCheck(env, ledgerSeq - 2, 2);
+        BEAST_EXPECT(goodLedger(
+            env,
+            env.rpc("ledger", std::to_string(early.seq)),
+            std::to_string(early.seq),
+            true));
+        BEAST_EXPECT(env.app().getNodeStore().fetchNodeObject(
+            early.accountHash, early.seq));
+    }
+
     void
     run() override
     {
         testClear();
         testAutomatic();
         testCanDelete();
+        testCopyToWritable();
+        testColdTier();
     }
 };
 
@@ -22,15 +22,20 @@
 #include <test/jtx/WSClient.h>
 #include <test/jtx/envconfig.h>
 #include <test/jtx/ticket.h>
+#include <test/unit_test/SuiteArgs.h>
 #include <xrpld/app/main/Application.h>
 #include <xrpld/app/misc/LoadFeeTrack.h>
 #include <xrpld/app/misc/TxQ.h>
 #include <xrpld/app/tx/apply.h>
+#include <xrpld/app/tx/applySteps.h>
 #include <xrpl/basics/Log.h>
+#include <xrpl/basics/random.h>
 #include <xrpl/protocol/ErrorCodes.h>
 #include <xrpl/protocol/jss.h>
 #include <xrpl/protocol/st.h>
 
+#include <chrono>
+
 namespace ripple {
 
 namespace test {
@@ -2474,6 +2479,57 @@ public:
         BEAST_EXPECT(env.balance(alice) == drops(5));
     }
 
+    void
+    testPreflightedApply()
+    {
+        // A transaction whose preflight ran before it reached the TxQ, as
+        // NetworkOPs does, is applied, queued or rejected just as if it
+        // had not.
+        testcase("preflighted apply");
+        using namespace jtx;
+
+        Account const alice("alice");
+        Account const bob("bob");
+
+        Env env(*this, makeConfig({{"minimum_txn_in_ledger_standalone", "3"}}));
+        env.fund(XRP(10000), alice, bob);
+        env.close();
+
+        auto applyPreflighted = [&](JTx const& jt, Rules const& rules) {
+            auto const pfresult =
+                preflight(env.app(), rules, *jt.stx, tapNONE, env.journal);
+            std::pair<TER, bool> result;
+            env.app().openLedger().modify(
+                [&](OpenView& view, beast::Journal j) {
+                    result = env.app().getTxQ().apply(
+                        env.app(), view, jt.stx, pfresult, j);
+                    return result.second;
+                });
+            return result;
+        };
+
+        auto const rules = env.current()->rules();
+
+        auto result = applyPreflighted(env.jt(noop(alice)), rules);
+        BEAST_EXPECT(result == std::make_pair(TER{tesSUCCESS}, true));
+
+        result = applyPreflighted(env.jt(pay(alice, bob, XRP(-1))), rules);
+        BEAST_EXPECT(result == std::make_pair(TER{temBAD_AMOUNT}, false));
+
+        fillQueue(env, alice);
+        auto const seqBob = env.seq(bob);
+        result = applyPreflighted(env.jt(noop(bob)), rules);
+        BEAST_EXPECT(result == std::make_pair(TER{terQUEUED}, false));
+
+        // Preflight under other rules is run again.
+        Rules const stale{env.app().config().features};
+        BEAST_EXPECT(stale != rules);
+        result = applyPreflighted(env.jt(noop(bob), seq(seqBob + 1)), stale);
+        BEAST_EXPECT(result == std::make_pair(TER{terQUEUED}, false));
+        BEAST_EXPECT(
+            env.app().getTxQ().getMetrics(*env.current()).txCount == 2);
+    }
+
     void
     testConsequences()
     {
@@ -4956,6 +5012,7 @@ public:
         testBlockersTicket();
         testInFlightBalance();
         testConsequences();
+        testPreflightedApply();
     }
 
     void
@@ -4989,8 +5046,120 @@ class TxQMetaInfo_test : public TxQPosNegFlows_test
     }
 };
 
+/** Times the queue with many senders and transactions queued at once.
+
+    Manual: pass accounts=<n>,per=<m> to queue m transactions from each of
+    n accounts. The defaults queue 100,000 transactions.
+*/
+class TxQBench_test : public beast::unit_test::suite
+{
+    using clock_type = std::chrono::steady_clock;
+
+    static double
+    toMillis(clock_type::duration d)
+    {
+        return std::chrono::duration<double, std::milli>(d).count();
+    }
+
+public:
+    void
+    run() override
+    {
+        using namespace jtx;
+
+        std::size_t accounts = 10000;
+        std::size_t per = 10;
+        SuiteArgs args(arg());
+        args.get("accounts", accounts);
+        args.get("per", per);
+        args.done();
+
+        testcase(
+            std::to_string(accounts) + " accounts, " + std::to_string(per) +
+            " each");
+
+        auto cfg = envconfig();
+        auto& section = cfg->section("transaction_queue");
+        section.set("minimum_txn_in_ledger_standalone", "1000");
+        section.set("target_txn_in_ledger", "1000");
+        section.set("normal_consensus_increase_percent", "0");
+        section.set("minimum_queue_size", std::to_string(accounts * per));
+        section.set("maximum_txn_per_account", std::to_string(per));
+        Env env(*this, std::move(cfg));
+
+        // Fund in batches small enough that nothing is queued.
+        std::vector<Account> senders;
+        senders.reserve(accounts);
+        for (std::size_t i = 0; i < accounts; ++i)
+        {
+            senders.emplace_back("sender" + std::to_string(i));
+            env.fund(XRP(1000), noripple(senders.back()));
+            if (i % 500 == 499)
+                env.close();
+        }
+        env.close();
+
+        // Sign everything up front so that only the queue is timed. Varied
+        // fees spread the transactions over many fee levels.
+        std::vector<std::shared_ptr<STTx const>> txs;
+        txs.reserve(accounts * per);
+        for (std::size_t n = 0; n < per; ++n)
+        {
+            for (auto const& sender : senders)
+                txs.push_back(env.jt(
+                                     noop(sender),
+                                     seq(env.seq(sender) + n),
+                                     fee(drops(10 + rand_int(90))))
+                                  .stx);
+        }
+
+        auto& txq = env.app().getTxQ();
+        clock_type::duration applyTime{};
+        std::size_t failed = 0;
+        env.app().openLedger().modify(
+            [&](OpenView& view, beast::Journal j) {
+                auto const start = clock_type::now();
+                for (auto const& tx : txs)
+                {
+                    auto const result =
+                        txq.apply(env.app(), view, tx, tapNONE, j);
+                    if (!result.second && result.first != terQUEUED)
+                        ++failed;
+                }
+                applyTime = clock_type::now() - start;
+                return true;
+            });
+
+        auto const queued = txq.getMetrics(*env.current()).txCount;
+        log << "apply: " << txs.size() << " transactions, " << queued
+            << " queued, " << failed << " rejected, "
+            << toMillis(applyTime) * 1000 / txs.size() << " us each"
+            << std::endl;
+        BEAST_EXPECT(failed == 0);
+
+        auto start = clock_type::now();
+        for (auto const& sender : senders)
+            txq.getAccountTxs(sender.id());
+        log << "lookup: "
+            << toMillis(clock_type::now() - start) * 1000 / senders.size()
+            << " us per account" << std::endl;
+
+        // Each close accepts from, and rebuilds, the full queue.
+        for (int i = 0; i < 3; ++i)
+        {
+            start = clock_type::now();
+            env.close();
+            log << "close: " << toMillis(clock_type::now() - start)
+                << " ms, "
+                << txq.getMetrics(*env.current()).txCount << " queued"
+                << std::endl;
+        }
+    }
+};
+
 BEAST_DEFINE_TESTSUITE_PRIO(TxQPosNegFlows, app, ripple, 1);
 BEAST_DEFINE_TESTSUITE_PRIO(TxQMetaInfo, app, ripple, 1);
+BEAST_DEFINE_TESTSUITE_MANUAL(TxQBench, app, ripple);
 
 }  // namespace test
 }  // namespace ripple
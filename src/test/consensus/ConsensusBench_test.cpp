@@ -0,0 +1,246 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <test/csf.h>
+#include <test/unit_test/SuiteArgs.h>
+#include <xrpl/beast/unit_test.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace ripple {
+namespace test {
+
+/** The cost of running consensus in a network of realistic size.
+
+    Simulates a network of validators, and of tracking nodes which follow
+    them, with lognormally distributed link delays and a steady stream of
+    transactions submitted to random nodes. Reports the wall time taken
+    per simulated round, and the wall time each node spent in consensus
+    per round.
+
+    A simulation runs on a single thread, since its events are ordered by
+    one scheduler. Independent simulations, each with its own seed, run
+    on as many threads as requested, to measure throughput on many cores.
+
+    Parameters, as a comma separated list of key=value pairs:
+        validators  The number of validators (default 150).
+        trackers    The number of tracking nodes (default 1000).
+        links       Random links made by each node (default 10).
+        latency     Median link delay in milliseconds (default 50).
+        rate        Transactions submitted per second (default 100).
+        seconds     Simulated time, after the first round (default 30).
+        runs        Independent simulations (default 1).
+        threads     Simulations run at once (default 1).
+*/
+class ConsensusBench_test : public beast::unit_test::suite
+{
+    struct Params
+    {
+        std::size_t validators = 150;
+        std::size_t trackers = 1000;
+        std::size_t links = 10;
+        std::size_t latency = 50;
+        std::size_t rate = 100;
+        std::size_t seconds = 30;
+        std::size_t runs = 1;
+        std::size_t threads = 1;
+    };
+
+    struct Result
+    {
+        std::size_t rounds = 0;
+        std::chrono::nanoseconds wall{0};
+        std::chrono::nanoseconds validatorTime{0};
+        std::chrono::nanoseconds trackerTime{0};
+        bool synchronized = false;
+        std::size_t branches = 0;
+    };
+
+    Params
+    parse() const
+    {
+        Params params;
+        SuiteArgs args(arg());
+        args.get("validators", params.validators);
+        args.get("trackers", params.trackers, 0);
+        args.get("links", params.links);
+        args.get("latency", params.latency);
+        args.get("rate", params.rate);
+        args.get("seconds", params.seconds);
+        args.get("runs", params.runs);
+        args.get("threads", params.threads);
+        args.done();
+        return params;
+    }
+
+    static Result
+    simulate(Params const& params, std::uint64_t seed)
+    {
+        using namespace csf;
+        using namespace std::chrono;
+
+        Sim sim;
+        sim.rng.seed(seed);
+
+        PeerGroup validators = sim.createGroup(params.validators);
+        PeerGroup trackers = sim.createGroup(params.trackers);
+        for (Peer* p : trackers)
+            p->runAsValidator = false;
+        PeerGroup network = validators + trackers;
+
+        // Everyone follows the validators
+        network.trust(validators);
+
+        // Each node links to random others, with one way delays spread
+        // around the median as on the internet.
+        std::lognormal_distribution<double> delay(
+            std::log(static_cast<double>(params.latency)), 0.5);
+        std::uniform_int_distribution<std::size_t> pick(
+            0, network.size() - 1);
+        for (Peer* p : network)
+        {
+            for (std::size_t i = 0;
+                 i < std::min(params.links, network.size() - 1);)
+            {
+                Peer* const q = network[pick(sim.rng)];
+                if (q == p)
+                    continue;
+                auto const ms = std::clamp(delay(sim.rng), 1.0, 2000.0);
+                if (p->connect(*q, milliseconds(std::lround(ms))))
+                    ++i;
+            }
+        }
+
+        // The first round, to set prior state
+        sim.run(1);
+        auto const first = validators[0]->lastClosedLedger.seq();
+
+        auto selector = makeSelector(
+            network.begin(),
+            network.end(),
+            std::vector<double>(network.size(), 1.),
+            sim.rng);
+        auto submitter = makeSubmitter(
+            ConstantDistribution{Rate{params.rate, 1000ms}.inv()},
+            sim.scheduler.now(),
+            sim.scheduler.now() + seconds(params.seconds),
+            selector,
+            sim.scheduler,
+            sim.rng);
+
+        for (Peer* p : network)
+            p->consensusTime = 0ns;
+
+        Result result;
+        auto const start = steady_clock::now();
+        sim.run(seconds(params.seconds));
+        result.wall = steady_clock::now() - start;
+
+        result.rounds = static_cast<std::uint32_t>(
+            validators[0]->lastClosedLedger.seq() - first);
+        for (Peer const* p : validators)
+            result.validatorTime += p->consensusTime;
+        for (Peer const* p : trackers)
+            result.trackerTime += p->consensusTime;
+
+        // Let the round in progress finish before checking the outcome
+        sim.run(1);
+        result.synchronized = sim.synchronized();
+        result.branches = sim.branches();
+        return result;
+    }
+
+public:
+    void
+    run() override
+    {
+        using namespace std::chrono;
+
+        auto const params = parse();
+        testcase(
+            std::to_string(params.validators) + " validators, " +
+            std::to_string(params.trackers) + " trackers, " +
+            std::to_string(params.runs) + " runs on " +
+            std::to_string(params.threads) + " threads");
+
+        std::vector<Result> results(params.runs);
+        std::mutex mutex;
+        std::size_t next = 0;
+        auto const work = [&]() {
+            for (;;)
+            {
+                std::size_t run;
+                {
+                    std::lock_guard lock(mutex);
+                    if (next == results.size())
+                        return;
+                    run = next++;
+                }
+                results[run] = simulate(params, run + 1);
+            }
+        };
+
+        auto const start = steady_clock::now();
+        std::vector<std::thread> threads;
+        for (std::size_t i = 1; i < std::min(params.threads, params.runs); ++i)
+            threads.emplace_back(work);
+        work();
+        for (auto& t : threads)
+            t.join();
+        auto const elapsed = steady_clock::now() - start;
+
+        auto const perRound = [](nanoseconds total, double rounds) {
+            return duration<double, std::milli>(total).count() /
+                std::max(rounds, 1.0);
+        };
+
+        log << std::fixed << std::setprecision(3);
+        std::size_t rounds = 0;
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            auto const& r = results[i];
+            rounds += r.rounds;
+            log << "run " << i + 1 << ": " << r.rounds << " rounds, "
+                << perRound(r.wall, r.rounds) << " ms/round, consensus "
+                << perRound(r.validatorTime, r.rounds * params.validators)
+                << " ms/round per validator, "
+                << perRound(r.trackerTime, r.rounds * params.trackers)
+                << " ms/round per tracker" << std::endl;
+
+            BEAST_EXPECT(r.rounds > 0);
+            BEAST_EXPECT(r.synchronized);
+            BEAST_EXPECT(r.branches == 1);
+        }
+        log << "total: " << rounds << " rounds in "
+            << duration_cast<milliseconds>(elapsed).count()
+            << " ms including setup, " << perRound(elapsed, rounds)
+            << " ms/round" << std::endl;
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(ConsensusBench, consensus, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -22,6 +22,9 @@
 #include <xrpld/consensus/ConsensusProposal.h>
 #include <xrpl/beast/clock/manual_clock.h>
 #include <xrpl/beast/unit_test.h>
+#include <map>
+#include <set>
+#include <string>
 #include <utility>
 
 namespace ripple {
@@ -177,6 +180,16 @@ public:
                 // All transactions were accepted
                 for (std::uint32_t i = 0; i < peers.size(); ++i)
                     BEAST_EXPECT(lcl.txs().find(Tx{i}) != lcl.txs().end());
+
+                // Where the time of the round went
+                auto const& timing = peer->prevTiming;
+                BEAST_EXPECT(timing.proposers == peers.size() - 1);
+                BEAST_EXPECT(timing.proposals >= peers.size() - 1);
+                BEAST_EXPECT(timing.closeTimeAgreed);
+                BEAST_EXPECT(timing.establish == peer->prevRoundTime);
+                BEAST_EXPECT(timing.open > 0ms);
+                BEAST_EXPECT(timing.firstProposal <= timing.medianProposal);
+                BEAST_EXPECT(timing.medianProposal <= timing.lastProposal);
             }
         }
     }
@@ -1052,6 +1065,137 @@ public:
         BEAST_EXPECT(sim.synchronized());
     }
 
+    void
+    testDisputeVotes()
+    {
+        using namespace csf;
+        using namespace std::chrono;
+        testcase("dispute votes");
+
+        // Six peers close with one transaction and four with one each of
+        // their own. The four change their position to the six, which is
+        // not yet enough to agree, so they go on voting on the disputes
+        ConsensusParms const parms{};
+        Sim sim;
+        PeerGroup network = sim.createGroup(10);
+        network.trustAndConnect(
+            network, round<milliseconds>(0.2 * parms.ledgerGRANULARITY));
+        for (std::size_t i = 0; i < network.size(); ++i)
+            network[i]->openTxs.insert(Tx{i < 6 ? 100u : 200u + i});
+
+        // Every vote on a dispute, whether it came from the cached
+        // differences or not, is whether the peer's set has the transaction
+        std::size_t checked = 0;
+        std::size_t checkedAfterRebase = 0;
+        std::size_t wrong = 0;
+        auto const check = [&](Peer const& peer) {
+            using std::to_string;
+
+            auto const json = peer.consensus.getJson(true);
+            if (!json.isMember("disputes"))
+                return;
+
+            std::map<std::string, TxSet const*> acquired;
+            for (auto const& [id, set] : peer.txSets)
+                acquired.emplace(to_string(id), &set);
+            std::set<std::string> consensusAcquired;
+            for (auto const& id : json["acquired"])
+                consensusAcquired.insert(id.asString());
+            bool const rebased =
+                json["tx_set_diffs"]["rebased"].asUInt() > 0;
+
+            auto const& disputes = json["disputes"];
+            for (auto const& txId : disputes.getMemberNames())
+            {
+                auto const& votes = disputes[txId]["votes"];
+                if (votes.isNull())
+                    continue;
+                for (auto const& node : votes.getMemberNames())
+                {
+                    auto const& position = json["peer_positions"][node];
+                    if (!position.isMember(jss::transaction_hash))
+                        continue;
+                    auto const setId =
+                        position[jss::transaction_hash].asString();
+                    auto const it = acquired.find(setId);
+                    if (it == acquired.end() ||
+                        !consensusAcquired.count(setId))
+                        continue;
+
+                    if (votes[node].asBool() !=
+                        it->second->exists(std::stoul(txId)))
+                        ++wrong;
+                    ++checked;
+                    if (rebased)
+                        ++checkedAfterRebase;
+                }
+            }
+        };
+
+        for (Peer* peer : network)
+        {
+            peer->targetLedgers = peer->completedLedgers + 1;
+            peer->start();
+        }
+        while (sim.scheduler.step_one())
+        {
+            for (Peer const* peer : network)
+                check(*peer);
+        }
+
+        BEAST_EXPECT(sim.synchronized());
+        BEAST_EXPECT(checked > 0);
+        BEAST_EXPECT(checkedAfterRebase > 0);
+        BEAST_EXPECT(wrong == 0);
+        for (Peer const* peer : network)
+        {
+            auto const& txs = peer->lastClosedLedger.txs();
+            BEAST_EXPECT(txs.find(Tx{100}) != txs.end());
+            BEAST_EXPECT(txs.size() == 1);
+        }
+    }
+
+    void
+    testRoundTiming()
+    {
+        using namespace std::chrono;
+        testcase("round timing");
+
+        ConsensusTimingHistory history(50);
+        BEAST_EXPECT(!history.last());
+        BEAST_EXPECT(history.getJson(16)["rounds"].asInt() == 0);
+
+        // Rounds 1 to 100, of which the last 50 are kept
+        for (std::uint32_t i = 1; i <= 100; ++i)
+        {
+            ConsensusRoundTiming timing;
+            timing.seq = i;
+            timing.establish = milliseconds{i};
+            timing.closeTimeAgreed = i % 2 == 0;
+            history.add(timing);
+        }
+        BEAST_EXPECT(history.size() == 50);
+        BEAST_EXPECT(history.last() && history.last()->seq == 100);
+
+        auto const json = history.getJson(3);
+        BEAST_EXPECT(json["rounds"].asInt() == 50);
+        BEAST_EXPECT(json["close_time_agreed"].asInt() == 25);
+
+        auto const& establish = json["percentiles"]["establish_ms"];
+        BEAST_EXPECT(establish["p50"].asInt() == 75);
+        BEAST_EXPECT(establish["p90"].asInt() == 95);
+        BEAST_EXPECT(establish["p99"].asInt() == 100);
+        BEAST_EXPECT(establish["max"].asInt() == 100);
+
+        // The most recent rounds first
+        auto const& recent = json["recent"];
+        if (BEAST_EXPECT(recent.size() == 3))
+        {
+            BEAST_EXPECT(recent[0u]["ledger_seq"].asUInt() == 100);
+            BEAST_EXPECT(recent[2u]["ledger_seq"].asUInt() == 98);
+        }
+    }
+
     void
     run() override
     {
@@ -1068,6 +1212,8 @@ public:
         testHubNetwork();
         testPreferredByBranch();
         testPauseForLaggards();
+        testDisputeVotes();
+        testRoundTiming();
     }
 };
 
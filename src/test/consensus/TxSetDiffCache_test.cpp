@@ -0,0 +1,283 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <test/csf.h>
+#include <test/unit_test/SuiteArgs.h>
+#include <xrpld/consensus/TxSetDiffCache.h>
+#include <xrpl/beast/unit_test.h>
+#include <chrono>
+#include <random>
+
+namespace ripple {
+namespace test {
+
+class TxSetDiffCache_test : public beast::unit_test::suite
+{
+    using TxSet = csf::TxSet;
+
+    static TxSet
+    makeSet(std::initializer_list<csf::Tx::ID> ids)
+    {
+        csf::TxSetType txs;
+        for (auto const id : ids)
+            txs.insert(csf::Tx{id});
+        return TxSet{txs};
+    }
+
+    void
+    testDiff()
+    {
+        testcase("diff");
+
+        TxSetDiffCache<TxSet> cache;
+        auto const a = makeSet({1, 2, 3});
+        auto const b = makeSet({2, 3, 4});
+
+        auto const diff = cache.diff(a, b);
+        BEAST_EXPECT(diff && *diff == a.compare(b));
+        BEAST_EXPECT(cache.diff(a, b) == diff);
+        auto const same = cache.diff(a, a);
+        BEAST_EXPECT(same && same->empty());
+        BEAST_EXPECT(*cache.diff(b, a) == b.compare(a));
+        BEAST_EXPECT(cache.size() == 3);
+
+        auto const json = cache.getJson();
+        BEAST_EXPECT(json["hits"].asUInt() == 1);
+        BEAST_EXPECT(json["compares"].asUInt() == 2);
+
+        cache.clear();
+        BEAST_EXPECT(cache.size() == 0);
+    }
+
+    void
+    testRebase()
+    {
+        testcase("rebase");
+
+        std::mt19937 rng;
+        std::uniform_int_distribution<csf::Tx::ID> pick(0, 63);
+        auto const random = [&]() {
+            csf::TxSetType txs;
+            for (int i = 0; i < 32; ++i)
+                txs.insert(csf::Tx{pick(rng)});
+            return TxSet{txs};
+        };
+
+        for (int round = 0; round < 20; ++round)
+        {
+            TxSetDiffCache<TxSet> cache;
+            auto ours = random();
+            std::vector<TxSet> peers;
+            for (int i = 0; i < 5; ++i)
+            {
+                peers.push_back(random());
+                cache.diff(ours, peers.back());
+            }
+            cache.diff(ours, ours);
+
+            // Change our vote on some of the transactions
+            for (int step = 0; step < 5; ++step)
+            {
+                TxSet::MutableTxSet next{ours};
+                TxSetDiffCache<TxSet>::Diff changed;
+                for (int i = 0; i < 4; ++i)
+                {
+                    auto const id = pick(rng);
+                    if (changed.count(id))
+                        continue;
+                    changed[id] = ours.exists(id);
+                    if (ours.exists(id))
+                        next.erase(id);
+                    else
+                        next.insert(csf::Tx{id});
+                }
+                TxSet const to{std::move(next)};
+                cache.rebase(ours.id(), to.id(), changed);
+                ours = to;
+
+                auto const compares = cache.getJson()["compares"].asUInt();
+                for (auto const& peer : peers)
+                    BEAST_EXPECT(*cache.diff(ours, peer) == ours.compare(peer));
+                BEAST_EXPECT(cache.diff(ours, ours)->empty());
+                BEAST_EXPECT(
+                    cache.getJson()["compares"].asUInt() == compares);
+            }
+        }
+
+        // Only the differences against the old set are kept
+        TxSetDiffCache<TxSet> cache;
+        auto const a = makeSet({1});
+        auto const b = makeSet({2});
+        auto const c = makeSet({3});
+        cache.diff(a, c);
+        cache.diff(b, c);
+        cache.rebase(a.id(), b.id(), a.compare(b));
+        BEAST_EXPECT(cache.size() == 1);
+        BEAST_EXPECT(*cache.diff(b, c) == b.compare(c));
+    }
+
+    // A set whose comparisons list at most two differences
+    struct LimitedSet : TxSet
+    {
+        using TxSet::TxSet;
+
+        std::map<csf::Tx::ID, bool>
+        compare(LimitedSet const& other, bool& complete) const
+        {
+            auto diff = TxSet::compare(other);
+            complete = diff.size() <= 2;
+            while (diff.size() > 2)
+                diff.erase(std::prev(diff.end()));
+            return diff;
+        }
+    };
+
+    void
+    testIncomplete()
+    {
+        testcase("incomplete");
+
+        auto const make = [](std::initializer_list<csf::Tx::ID> ids) {
+            csf::TxSetType txs;
+            for (auto const id : ids)
+                txs.insert(csf::Tx{id});
+            return LimitedSet{txs};
+        };
+
+        TxSetDiffCache<LimitedSet> cache;
+        auto const a = make({1, 2, 3});
+        auto const b = make({4, 5, 6});
+        auto const c = make({1, 2, 4});
+
+        // Only the fact that the differences are incomplete is kept
+        BEAST_EXPECT(!cache.diff(a, b));
+        BEAST_EXPECT(!cache.diff(a, b));
+        BEAST_EXPECT(cache.diff(a, c));
+        auto json = cache.getJson();
+        BEAST_EXPECT(json["hits"].asUInt() == 1);
+        BEAST_EXPECT(json["compares"].asUInt() == 2);
+        BEAST_EXPECT(json["incomplete"].asUInt() == 1);
+
+        // Incomplete differences are not rebased
+        cache.rebase(a.id(), c.id(), a.TxSet::compare(c));
+        BEAST_EXPECT(cache.size() == 1);
+        BEAST_EXPECT(cache.diff(c, c)->empty());
+        BEAST_EXPECT(!cache.diff(c, b));
+        json = cache.getJson();
+        BEAST_EXPECT(json["compares"].asUInt() == 3);
+        BEAST_EXPECT(json["incomplete"].asUInt() == 2);
+    }
+
+public:
+    void
+    run() override
+    {
+        testDiff();
+        testRebase();
+        testIncomplete();
+    }
+};
+
+/** The cost of deciding disputes in a simulated network.
+
+    Runs a network of validators with uneven delays between them, so
+    that they close with different transactions, and reports the wall
+    time taken and how often the differences between sets were reused.
+
+    Parameters, as a comma separated list of key=value pairs:
+        peers   The number of validators (default 30).
+        rate    Transactions submitted per second (default 500).
+        seconds Simulated time (default 120).
+*/
+class TxSetDiffCacheBench_test : public beast::unit_test::suite
+{
+public:
+    void
+    run() override
+    {
+        using namespace csf;
+        using namespace std::chrono;
+
+        std::size_t numPeers = 30;
+        std::size_t rate = 500;
+        std::size_t seconds = 120;
+        SuiteArgs args(arg());
+        args.get("peers", numPeers);
+        args.get("rate", rate);
+        args.get("seconds", seconds);
+        args.done();
+
+        testcase(
+            std::to_string(numPeers) + " peers, " + std::to_string(rate) +
+            " tx/s, " + std::to_string(seconds) + " s");
+
+        Sim sim;
+        PeerGroup peers = sim.createGroup(numPeers);
+        peers.trust(peers);
+
+        // Uneven delays, so peers see transactions in a different order
+        std::uniform_int_distribution<int> delay(10, 800);
+        for (std::size_t i = 0; i < numPeers; ++i)
+            for (std::size_t j = i + 1; j < numPeers; ++j)
+                peers[i]->connect(*peers[j], milliseconds(delay(sim.rng)));
+
+        sim.run(1);
+
+        auto selector = makeSelector(
+            peers.begin(),
+            peers.end(),
+            std::vector<double>(numPeers, 1.),
+            sim.rng);
+        auto submitter = makeSubmitter(
+            ConstantDistribution{Rate{rate, 1000ms}.inv()},
+            sim.scheduler.now(),
+            sim.scheduler.now() + std::chrono::seconds(seconds),
+            selector,
+            sim.scheduler,
+            sim.rng);
+
+        auto const start = steady_clock::now();
+        sim.run(std::chrono::seconds(seconds));
+        auto const elapsed = steady_clock::now() - start;
+
+        std::uint64_t hits = 0;
+        std::uint64_t compares = 0;
+        std::uint64_t rebased = 0;
+        for (Peer const* peer : peers)
+        {
+            auto const json = peer->consensus.getJson(true)["tx_set_diffs"];
+            hits += json["hits"].asUInt();
+            compares += json["compares"].asUInt();
+            rebased += json["rebased"].asUInt();
+        }
+
+        log << "ledgers: " << peers[0]->lastClosedLedger.seq()
+            << ", wall time: " << duration_cast<milliseconds>(elapsed).count()
+            << " ms" << std::endl;
+        log << "set compares: " << compares << ", reused: " << hits
+            << ", rebased: " << rebased << std::endl;
+        BEAST_EXPECT(sim.synchronized());
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(TxSetDiffCache, consensus, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(TxSetDiffCacheBench, consensus, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -18,11 +18,13 @@
 //==============================================================================
 
 #include <test/csf/Validation.h>
+#include <test/unit_test/SuiteArgs.h>
 #include <test/unit_test/SuiteJournal.h>
 #include <xrpld/consensus/Validations.h>
 #include <xrpl/basics/tagged_integer.h>
 #include <xrpl/beast/clock/manual_clock.h>
 #include <xrpl/beast/unit_test.h>
+#include <chrono>
 #include <memory>
 #include <tuple>
 #include <type_traits>
@@ -33,6 +35,7 @@ namespace test {
 namespace csf {
 class Validations_test : public beast::unit_test::suite
 {
+protected:
     using clock_type = beast::abstract_clock<std::chrono::steady_clock> const;
 
     // Helper to convert steady_clock to a reasonable NetClock
@@ -171,6 +174,7 @@ class Validations_test : public beast::unit_test::suite
     {
         clock_type& c_;
         LedgerOracle& oracle_;
+        std::size_t acquires_ = 0;
 
     public:
         // Non-locking mutex to avoid locks in generic Validations
@@ -203,8 +207,16 @@ class Validations_test : public beast::unit_test::suite
         std::optional<Ledger>
         acquire(Ledger::ID const& id)
         {
+            ++acquires_;
             return oracle_.lookup(id);
         }
+
+        // Number of ledger lookups, which are costly outside of tests
+        std::size_t
+        acquires() const
+        {
+            return acquires_;
+        }
     };
 
     // Specialize generic Validations using the above types
@@ -1145,7 +1157,116 @@ class Validations_test : public beast::unit_test::suite
     }
 };
 
+// Time Validations::add and getPreferred under a storm of validations.
+// Parameters, as comma separated key=value pairs in the suite argument:
+//   trusted    trusted validators (150)
+//   untrusted  untrusted validators relaying validations (1000)
+//   rounds     ledgers validated (100)
+//   reads      validations added between calls to getPreferred (100)
+class ValidationsBench_test : public Validations_test
+{
+    using steady_clock = std::chrono::steady_clock;
+
+    static double
+    toMicros(steady_clock::duration d)
+    {
+        return std::chrono::duration<double, std::micro>(d).count();
+    }
+
+public:
+    void
+    run() override
+    {
+        using namespace std::chrono_literals;
+
+        std::size_t trusted = 150;
+        std::size_t untrusted = 1000;
+        std::size_t rounds = 100;
+        std::size_t reads = 100;
+        SuiteArgs args(arg());
+        args.get("trusted", trusted, 0);
+        args.get("untrusted", untrusted, 0);
+        args.get("rounds", rounds, 0);
+        args.get("reads", reads);
+        args.done();
+
+        testcase(
+            std::to_string(trusted) + " trusted, " +
+            std::to_string(untrusted) + " untrusted, " +
+            std::to_string(rounds) + " rounds");
+
+        LedgerHistoryHelper h;
+        TestHarness harness(h.oracle);
+        std::vector<Node> nodes;
+        for (std::size_t i = 0; i < trusted + untrusted; ++i)
+        {
+            nodes.push_back(harness.makeNode());
+            if (i >= trusted)
+                nodes.back().untrust();
+        }
+
+        steady_clock::duration addTime{};
+        steady_clock::duration readTime{};
+        std::size_t added = 0;
+        std::size_t read = 0;
+        Ledger ledger = genesisLedger;
+        for (std::size_t r = 0; r < rounds; ++r)
+        {
+            ledger = h.oracle.accept(ledger, Tx{static_cast<Tx::ID>(r)});
+            harness.clock().advance(1s);
+
+            // Validations for the new ledger, with a few trusted validators
+            // on a ledger this node does not have.
+            std::vector<Validation> vals;
+            vals.reserve(nodes.size());
+            for (std::size_t i = 0; i < nodes.size(); ++i)
+            {
+                if (i < trusted && i % 20 == 19)
+                    vals.push_back(nodes[i].validate(
+                        Ledger::ID{static_cast<std::uint32_t>(1000000 + r)},
+                        ledger.seq(),
+                        0s,
+                        0s,
+                        true));
+                else
+                    vals.push_back(nodes[i].validate(ledger));
+            }
+
+            for (auto const& val : vals)
+            {
+                auto const start = steady_clock::now();
+                auto const status = harness.add(val);
+                addTime += steady_clock::now() - start;
+                BEAST_EXPECT(status == ValStatus::current);
+
+                if (++added % reads == 0)
+                {
+                    auto const start = steady_clock::now();
+                    harness.vals().getPreferred(genesisLedger);
+                    readTime += steady_clock::now() - start;
+                    ++read;
+                }
+            }
+        }
+
+        if (trusted > 0)
+            BEAST_EXPECT(
+                harness.vals().getPreferred(genesisLedger) ==
+                std::make_pair(ledger.seq(), ledger.id()));
+
+        log << "add: " << added << " validations, "
+            << toMicros(addTime) / std::max<std::size_t>(added, 1)
+            << " us each" << std::endl;
+        log << "getPreferred: " << read << " calls, "
+            << toMicros(readTime) / std::max<std::size_t>(read, 1)
+            << " us each" << std::endl;
+        log << "acquire: " << harness.vals().adaptor().acquires()
+            << " ledger lookups" << std::endl;
+    }
+};
+
 BEAST_DEFINE_TESTSUITE(Validations, consensus, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(ValidationsBench, consensus, ripple);
 }  // namespace csf
 }  // namespace test
 }  // namespace ripple
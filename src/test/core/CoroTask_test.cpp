@@ -0,0 +1,534 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <test/jtx.h>
+#include <xrpld/core/JobQueue.h>
+#include <xrpl/beast/unit_test.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace ripple {
+namespace test {
+
+class CoroTask_test : public beast::unit_test::suite
+{
+public:
+    class gate
+    {
+    private:
+        std::condition_variable cv_;
+        std::mutex mutex_;
+        bool signaled_ = false;
+
+    public:
+        // Thread safe, blocks until signaled or period expires.
+        // Returns `true` if signaled.
+        template <class Rep, class Period>
+        bool
+        wait_for(std::chrono::duration<Rep, Period> const& rel_time)
+        {
+            std::unique_lock<std::mutex> lk(mutex_);
+            auto b = cv_.wait_for(lk, rel_time, [this] { return signaled_; });
+            signaled_ = false;
+            return b;
+        }
+
+        void
+        signal()
+        {
+            std::lock_guard lk(mutex_);
+            signaled_ = true;
+            cv_.notify_all();
+        }
+    };
+
+private:
+    using Resumer = JobQueue::CoroTask::Resumer;
+
+    static JobQueue::CoroTask
+    signalOnce(gate& g)
+    {
+        g.signal();
+        co_return;
+    }
+
+    static JobQueue::CoroTask
+    suspendOnce(
+        JobQueue& jq,
+        std::optional<Resumer>& resumer,
+        gate& suspended,
+        gate& finished)
+    {
+        co_await jq.suspendCoroTask(jtCLIENT, "CoroTask-Test", [&](auto r) {
+            resumer.emplace(std::move(r));
+            suspended.signal();
+        });
+        finished.signal();
+    }
+
+    static JobQueue::CoroTask
+    resumeBeforeSuspend(JobQueue& jq, int count, gate& finished)
+    {
+        for (int i = 0; i < count; ++i)
+            co_await jq.suspendCoroTask(
+                jtCLIENT, "CoroTask-Test", [](auto r) { r(); });
+        finished.signal();
+    }
+
+    static JobQueue::CoroTask
+    useLocalValue(
+        JobQueue& jq,
+        int id,
+        LocalValue<int>& lv,
+        std::function<void()>& resume,
+        gate& g,
+        beast::unit_test::suite& suite)
+    {
+        auto suspend = [&]() {
+            return jq.suspendCoroTask(
+                jtCLIENT, "CoroTask-Test", [&](Resumer r) {
+                    resume = r;
+                    g.signal();
+                });
+        };
+
+        co_await suspend();
+        suite.expect(*lv == -1);
+        *lv = id;
+        suite.expect(*lv == id);
+
+        co_await suspend();
+        suite.expect(*lv == id);
+        g.signal();
+    }
+
+    static JobQueue::CoroTask
+    throwAfterSuspend(
+        JobQueue& jq,
+        std::optional<Resumer>& resumer,
+        gate& suspended,
+        LocalValue<int>& lv,
+        std::shared_ptr<int> frame)
+    {
+        *lv = 1;
+        co_await jq.suspendCoroTask(jtCLIENT, "CoroTask-Test", [&](auto r) {
+            resumer.emplace(std::move(r));
+            suspended.signal();
+        });
+        Throw<std::runtime_error>("CoroTask-Test");
+    }
+
+    void
+    testPost()
+    {
+        using namespace std::chrono_literals;
+        using namespace jtx;
+
+        testcase("post");
+
+        Env env(*this, envconfig([](std::unique_ptr<Config> cfg) {
+            cfg->FORCE_MULTI_THREAD = true;
+            return cfg;
+        }));
+
+        gate g;
+        BEAST_EXPECT(env.app().getJobQueue().postCoroTask(
+            jtCLIENT, "CoroTask-Test", signalOnce(g)));
+        BEAST_EXPECT(g.wait_for(5s));
+    }
+
+    void
+    testSuspend()
+    {
+        using namespace std::chrono_literals;
+        using namespace jtx;
+
+        testcase("suspend and resume");
+
+        Env env(*this, envconfig([](std::unique_ptr<Config> cfg) {
+            cfg->FORCE_MULTI_THREAD = true;
+            return cfg;
+        }));
+
+        auto& jq = env.app().getJobQueue();
+
+        gate suspended, finished;
+        std::optional<Resumer> resumer;
+        BEAST_EXPECT(jq.postCoroTask(
+            jtCLIENT,
+            "CoroTask-Test",
+            suspendOnce(jq, resumer, suspended, finished)));
+        BEAST_EXPECT(suspended.wait_for(5s));
+        BEAST_EXPECT(!finished.wait_for(10ms));
+        if (BEAST_EXPECT(resumer))
+            (*resumer)();
+        BEAST_EXPECT(finished.wait_for(5s));
+    }
+
+    void
+    testResumeBeforeSuspend()
+    {
+        using namespace std::chrono_literals;
+        using namespace jtx;
+
+        testcase("resume before suspend");
+
+        Env env(*this, envconfig([](std::unique_ptr<Config> cfg) {
+            cfg->FORCE_MULTI_THREAD = true;
+            return cfg;
+        }));
+
+        auto& jq = env.app().getJobQueue();
+
+        // The resumption job is queued before await_suspend returns, so
+        // with several worker threads it often runs concurrently with it.
+        gate finished;
+        BEAST_EXPECT(jq.postCoroTask(
+            jtCLIENT, "CoroTask-Test", resumeBeforeSuspend(jq, 100, finished)));
+        BEAST_EXPECT(finished.wait_for(5s));
+    }
+
+    void
+    testThreadSpecificStorage()
+    {
+        using namespace std::chrono_literals;
+        using namespace jtx;
+
+        testcase("thread specific storage");
+        Env env(*this);
+
+        auto& jq = env.app().getJobQueue();
+
+        static int const N = 4;
+        std::array<std::function<void()>, N> resume;
+
+        LocalValue<int> lv(-1);
+        BEAST_EXPECT(*lv == -1);
+
+        gate g;
+        jq.addJob(jtCLIENT, "LocalValue-Test", [&]() {
+            this->BEAST_EXPECT(*lv == -1);
+            *lv = -2;
+            this->BEAST_EXPECT(*lv == -2);
+            g.signal();
+        });
+        BEAST_EXPECT(g.wait_for(5s));
+        BEAST_EXPECT(*lv == -1);
+
+        for (int i = 0; i < N; ++i)
+        {
+            BEAST_EXPECT(jq.postCoroTask(
+                jtCLIENT,
+                "CoroTask-Test",
+                useLocalValue(jq, i, lv, resume[i], g, *this)));
+            BEAST_EXPECT(g.wait_for(5s));
+        }
+        for (auto const& r : resume)
+        {
+            // The task assigns a new Resumer once it resumes, so invoke a
+            // copy.
+            auto const copy = r;
+            copy();
+            BEAST_EXPECT(g.wait_for(5s));
+        }
+        for (auto const& r : resume)
+        {
+            // The task assigns a new Resumer once it resumes, so invoke a
+            // copy.
+            auto const copy = r;
+            copy();
+            BEAST_EXPECT(g.wait_for(5s));
+        }
+
+        jq.addJob(jtCLIENT, "LocalValue-Test", [&]() {
+            this->BEAST_EXPECT(*lv == -2);
+            g.signal();
+        });
+        BEAST_EXPECT(g.wait_for(5s));
+        BEAST_EXPECT(*lv == -1);
+    }
+
+    void
+    testException()
+    {
+        using namespace std::chrono_literals;
+        using namespace jtx;
+
+        testcase("exception");
+
+        Env env(*this, envconfig([](std::unique_ptr<Config> cfg) {
+            cfg->FORCE_MULTI_THREAD = true;
+            return cfg;
+        }));
+
+        auto& jq = env.app().getJobQueue();
+
+        // The frame holds a copy of the pointer until it is destroyed
+        LocalValue<int> lv(-1);
+        auto const frame = std::make_shared<int>(0);
+        gate suspended;
+        std::optional<Resumer> resumer;
+        BEAST_EXPECT(jq.postCoroTask(
+            jtCLIENT,
+            "CoroTask-Test",
+            throwAfterSuspend(jq, resumer, suspended, lv, frame)));
+        BEAST_EXPECT(suspended.wait_for(5s));
+        if (!BEAST_EXPECT(resumer))
+            return;
+
+        // An exception escaping a job ends the process, so the task is
+        // resumed on this thread instead, which the Resumer does once the
+        // queue no longer takes jobs. A job holds stop() back until then.
+        gate running, release;
+        BEAST_EXPECT(jq.addJob(jtCLIENT, "CoroTask-Test", [&]() {
+            running.signal();
+            release.wait_for(5s);
+        }));
+        BEAST_EXPECT(running.wait_for(5s));
+        std::thread stopper([&jq]() { jq.stop(); });
+        while (jq.addJob(jtCLIENT, "CoroTask-Test", []() {}))
+            std::this_thread::yield();
+
+        *lv = -2;
+        bool caught = false;
+        try
+        {
+            (*resumer)();
+        }
+        catch (std::runtime_error const& e)
+        {
+            caught = true;
+            BEAST_EXPECT(e.what() == std::string("CoroTask-Test"));
+            BEAST_EXPECT(frame.use_count() == 1);
+            BEAST_EXPECT(*lv == -2);
+        }
+        BEAST_EXPECT(caught);
+
+        release.signal();
+        stopper.join();
+    }
+
+public:
+    void
+    run() override
+    {
+        testPost();
+        testSuspend();
+        testResumeBeforeSuspend();
+        testThreadSpecificStorage();
+        testException();
+    }
+};
+
+// Compares the cost of suspending a request on a stackful Coro with the
+// cost of suspending it on a stackless CoroTask.
+class CoroTaskBench_test : public beast::unit_test::suite
+{
+    using Resumer = JobQueue::CoroTask::Resumer;
+    using gate = CoroTask_test::gate;
+
+    // Virtual and resident size of this process in bytes, or zero where
+    // /proc is not available. statm reports sizes in (usually 4k) pages.
+    static std::pair<std::size_t, std::size_t>
+    memoryUsage()
+    {
+        std::size_t size = 0;
+        std::size_t resident = 0;
+        std::ifstream statm("/proc/self/statm");
+        if (!(statm >> size >> resident))
+            return {0, 0};
+        return {size * 4096, resident * 4096};
+    }
+
+    static JobQueue::CoroTask
+    parked(
+        JobQueue& jq,
+        std::vector<Resumer>& resumers,
+        std::mutex& m,
+        std::atomic<int>& live,
+        gate& g)
+    {
+        co_await jq.suspendCoroTask(jtCLIENT, "CoroTask-Bench", [&](auto r) {
+            std::lock_guard lock(m);
+            resumers.push_back(std::move(r));
+            g.signal();
+        });
+        if (--live == 0)
+            g.signal();
+    }
+
+    static JobQueue::CoroTask
+    pingPong(JobQueue& jq, int count, gate& finished)
+    {
+        for (int i = 0; i < count; ++i)
+            co_await jq.suspendCoroTask(
+                jtCLIENT, "CoroTask-Bench", [](auto r) { r(); });
+        finished.signal();
+    }
+
+    void
+    report(
+        char const* what,
+        std::size_t n,
+        std::pair<std::size_t, std::size_t> const& before,
+        std::pair<std::size_t, std::size_t> const& after)
+    {
+        log << what << ": " << n << " suspended, "
+            << (after.first - before.first) / n << " virtual bytes and "
+            << (after.second - before.second) / n
+            << " resident bytes per request" << std::endl;
+    }
+
+    void
+    testMemory()
+    {
+        using namespace std::chrono_literals;
+        using namespace jtx;
+
+        testcase("memory per suspended request");
+
+        Env env(*this);
+        auto& jq = env.app().getJobQueue();
+
+        static std::size_t const N = 1000;
+        gate g;
+
+        {
+            std::vector<std::shared_ptr<JobQueue::Coro>> coros;
+            std::mutex m;
+            auto const before = memoryUsage();
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                jq.postCoro(jtCLIENT, "CoroTask-Bench", [&](auto const& c) {
+                    {
+                        std::lock_guard lock(m);
+                        coros.push_back(c);
+                    }
+                    g.signal();
+                    c->yield();
+                });
+                BEAST_EXPECT(g.wait_for(5s));
+            }
+            for (auto const& c : coros)
+                c->join();
+            report("Coro", N, before, memoryUsage());
+            for (auto const& c : coros)
+            {
+                c->post();
+                c->join();
+            }
+        }
+
+        {
+            std::vector<Resumer> resumers;
+            std::mutex m;
+            std::atomic<int> live = N;
+            auto const before = memoryUsage();
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                jq.postCoroTask(
+                    jtCLIENT,
+                    "CoroTask-Bench",
+                    parked(jq, resumers, m, live, g));
+                BEAST_EXPECT(g.wait_for(5s));
+            }
+            report("CoroTask", N, before, memoryUsage());
+            for (auto const& r : resumers)
+                r();
+            BEAST_EXPECT(g.wait_for(5s));
+        }
+    }
+
+    void
+    testThroughput()
+    {
+        using namespace std::chrono_literals;
+        using namespace jtx;
+        using clock = std::chrono::steady_clock;
+
+        testcase("suspend and resume throughput");
+
+        Env env(*this, envconfig([](std::unique_ptr<Config> cfg) {
+            cfg->FORCE_MULTI_THREAD = true;
+            return cfg;
+        }));
+        auto& jq = env.app().getJobQueue();
+
+        static int const N = 100000;
+        gate g;
+
+        {
+            auto const start = clock::now();
+            jq.postCoro(jtCLIENT, "CoroTask-Bench", [&](auto const& c) {
+                for (int i = 0; i < N; ++i)
+                {
+                    c->post();
+                    c->yield();
+                }
+                g.signal();
+            });
+            BEAST_EXPECT(g.wait_for(60s));
+            auto const elapsed = clock::now() - start;
+            log << "Coro: "
+                << std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       elapsed)
+                       .count() /
+                    N
+                << "ns per suspend" << std::endl;
+        }
+
+        {
+            auto const start = clock::now();
+            jq.postCoroTask(jtCLIENT, "CoroTask-Bench", pingPong(jq, N, g));
+            BEAST_EXPECT(g.wait_for(60s));
+            auto const elapsed = clock::now() - start;
+            log << "CoroTask: "
+                << std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       elapsed)
+                       .count() /
+                    N
+                << "ns per suspend" << std::endl;
+        }
+    }
+
+public:
+    void
+    run() override
+    {
+        testMemory();
+        testThroughput();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(CoroTask, core, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(CoroTaskBench, core, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -332,6 +332,12 @@ public:
         collectors_.emplace_back(collector);
     }
 
+    bool
+    empty() const
+    {
+        return collectors_.empty();
+    }
+
     template <class E>
     void
     on(PeerID node, SimTime when, E const& e)
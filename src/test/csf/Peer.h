@@ -33,6 +33,9 @@
 #include <boost/container/flat_map.hpp>
 #include <boost/container/flat_set.hpp>
 #include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
 
 namespace ripple {
 namespace test {
@@ -237,6 +240,12 @@ struct Peer
     std::size_t prevProposers = 0;
     // Duration of prior round
     std::chrono::milliseconds prevRoundTime;
+    // Where the time of the prior round went
+    ConsensusRoundTiming prevTiming;
+
+    //! Wall time spent in generic consensus, including the work it does
+    //! through this peer, for benchmarks
+    std::chrono::nanoseconds consensusTime{0};
 
     // Quorum of validations needed for a ledger to be fully validated
     // TODO: Use the logic in ValidatorList to set this dynamically
@@ -290,6 +299,36 @@ struct Peer
         trustGraph.trust(this, this);
     }
 
+    /** Adds the time spent in its scope to consensusTime.
+
+        Nested scopes are not counted again.
+    */
+    class MeasureConsensus
+    {
+        Peer& peer_;
+        bool const outer_;
+        std::chrono::steady_clock::time_point const start_;
+
+    public:
+        explicit MeasureConsensus(Peer& peer)
+            : peer_{peer}
+            , outer_{!peer.inConsensus_}
+            , start_{std::chrono::steady_clock::now()}
+        {
+            peer_.inConsensus_ = true;
+        }
+
+        ~MeasureConsensus()
+        {
+            if (!outer_)
+                return;
+            peer_.consensusTime += std::chrono::steady_clock::now() - start_;
+            peer_.inConsensus_ = false;
+        }
+    };
+
+    bool inConsensus_ = false;
+
     /**  Schedule the provided callback in `when` duration, but if
         `when` is 0, call immediately
     */
@@ -553,6 +592,7 @@ struct Peer
             issue(AcceptLedger{newLedger, lastClosedLedger});
             prevProposers = result.proposers;
             prevRoundTime = result.roundTime.read();
+            prevTiming = result.timing;
             lastClosedLedger = newLedger;
 
             auto const it = std::remove_if(
@@ -654,7 +694,10 @@ struct Peer
     share(M const& m)
     {
         issue(Share<M>{m});
-        send(BroadcastMesg<M>{m, router.nextSeq++, this->id}, this->id);
+        send(
+            BroadcastMesg<M>{
+                std::make_shared<M const>(m), router.nextSeq++, this->id},
+            this->id);
     }
 
     // Unwrap the Position and share the raw proposal
@@ -720,10 +763,12 @@ struct Peer
     //        before seq 2 from node 0, etc.
     //  TODO: Break this out into a class and identify type interface to allow
     //        alternate routing strategies
+    //
+    //  The message itself is shared by every copy flooded across the network.
     template <class M>
     struct BroadcastMesg
     {
-        M mesg;
+        std::shared_ptr<M const> mesg;
         std::size_t seq;
         PeerID origin;
     };
@@ -731,7 +776,19 @@ struct Peer
     struct Router
     {
         std::size_t nextSeq = 1;
-        bc::flat_map<PeerID, std::size_t> lastObservedSeq;
+
+        // Indexed by the ID of the origin, which the simulation assigns
+        // densely from zero
+        std::vector<std::size_t> lastObservedSeq;
+
+        std::size_t&
+        lastObserved(PeerID origin)
+        {
+            auto const i = static_cast<std::uint32_t>(origin);
+            if (i >= lastObservedSeq.size())
+                lastObservedSeq.resize(i + 1, 0);
+            return lastObservedSeq[i];
+        }
     };
 
     Router router;
@@ -747,9 +804,10 @@ struct Peer
             {
                 // cheat and don't bother sending if we know it has already been
                 // used on the other end
-                if (link.target->router.lastObservedSeq[bm.origin] < bm.seq)
+                if (link.target->router.lastObserved(bm.origin) < bm.seq)
                 {
-                    issue(Relay<M>{link.target->id, bm.mesg});
+                    if (!collectors.empty())
+                        issue(Relay<M>{link.target->id, *bm.mesg});
                     net.send(
                         this,
                         link.target,
@@ -766,12 +824,13 @@ struct Peer
     void
     receive(BroadcastMesg<M> const& bm, PeerID from)
     {
-        issue(Receive<M>{from, bm.mesg});
-        if (router.lastObservedSeq[bm.origin] < bm.seq)
+        if (!collectors.empty())
+            issue(Receive<M>{from, *bm.mesg});
+        if (auto& last = router.lastObserved(bm.origin); last < bm.seq)
         {
-            router.lastObservedSeq[bm.origin] = bm.seq;
-            schedule(delays.onReceive(bm.mesg), [this, bm, from] {
-                if (handle(bm.mesg))
+            last = bm.seq;
+            schedule(delays.onReceive(*bm.mesg), [this, bm, from] {
+                if (handle(*bm.mesg))
                     send(bm, from);
             });
         }
@@ -795,6 +854,7 @@ struct Peer
         dest.push_back(p);
 
         // Rely on consensus to decide whether to relay
+        MeasureConsensus measure{*this};
         return consensus.peerProposal(now(), Position{p});
     }
 
@@ -804,7 +864,10 @@ struct Peer
         bool const inserted =
             txSets.insert(std::make_pair(txs.id(), txs)).second;
         if (inserted)
+        {
+            MeasureConsensus measure{*this};
             consensus.gotTxSet(now(), txs);
+        }
         // relay only if new
         return inserted;
     }
@@ -887,7 +950,10 @@ struct Peer
     void
     timerEntry()
     {
-        consensus.timerEntry(now());
+        {
+            MeasureConsensus measure{*this};
+            consensus.timerEntry(now());
+        }
         // only reschedule if not completed
         if (completedLedgers < targetLedgers)
             scheduler.in(parms().ledgerGRANULARITY, [this]() { timerEntry(); });
@@ -909,6 +975,7 @@ struct Peer
 
         // Not yet modeling dynamic UNL.
         hash_set<PeerID> nowUntrusted;
+        MeasureConsensus measure{*this};
         consensus.startRound(
             now(), bestLCL, lastClosedLedger, nowUntrusted, runAsValidator);
     }
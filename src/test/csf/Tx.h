@@ -171,6 +171,14 @@ public:
         return res;
     }
 
+    /** The differences with another set, which are always complete. */
+    std::map<Tx::ID, bool>
+    compare(TxSet const& other, bool& complete) const
+    {
+        complete = true;
+        return compare(other);
+    }
+
 private:
     //! The set contains the actual transactions
     TxSetType txs_;
@@ -19,6 +19,8 @@
 
 #include <test/jtx.h>
 #include <xrpld/app/ledger/Ledger.h>
+#include <xrpld/app/ledger/LedgerMaster.h>
+#include <xrpld/app/ledger/OpenLedger.h>
 #include <xrpld/core/ConfigSections.h>
 #include <xrpld/ledger/ApplyViewImpl.h>
 #include <xrpld/ledger/OpenView.h>
@@ -1092,6 +1094,66 @@ class View_test : public beast::unit_test::suite
         }
     }
 
+    void
+    testOpenLedgerPrepare()
+    {
+        using namespace jtx;
+        testcase("OpenLedger prepare");
+
+        Env env(*this);
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+        Account const carol{"carol"};
+        env.fund(XRP(10000), alice, bob, carol);
+        env.close();
+
+        std::vector<uint256> ids;
+        env(noop(alice));
+        ids.push_back(env.tx()->getTransactionID());
+        env(noop(bob));
+        ids.push_back(env.tx()->getTransactionID());
+
+        auto& openLedger = env.app().openLedger();
+        auto const before = openLedger.getReplayStats();
+
+        // Rebuild the open ledger on the same closed ledger. Both open
+        // transactions are replayed by prepare.
+        OrderedTxs retries{uint256{}};
+        auto prepared = openLedger.prepare(
+            env.app(),
+            env.current()->rules(),
+            env.app().getLedgerMaster().getClosedLedger(),
+            false,
+            retries,
+            tapNONE);
+        BEAST_EXPECT(prepared.view->txCount() == 2);
+
+        // This one reaches the open ledger after the snapshot, so only
+        // accept can replay it.
+        env(noop(carol));
+        ids.push_back(env.tx()->getTransactionID());
+        openLedger.accept(
+            env.app(),
+            std::move(prepared),
+            OrderedTxs{uint256{}},
+            retries,
+            tapNONE);
+
+        auto const after = openLedger.getReplayStats();
+        BEAST_EXPECT(after.replayed - before.replayed == 2);
+        BEAST_EXPECT(after.replayedLocked - before.replayedLocked == 1);
+        BEAST_EXPECT(retries.empty());
+
+        auto const current = openLedger.current();
+        BEAST_EXPECT(current->txCount() == 3);
+        for (auto const& id : ids)
+            BEAST_EXPECT(current->txExists(id));
+
+        env.close();
+        for (auto const& id : ids)
+            BEAST_EXPECT(env.closed()->txExists(id));
+    }
+
     void
     run() override
     {
@@ -1109,6 +1171,7 @@ class View_test : public beast::unit_test::suite
         testTransferRate();
         testAreCompatible();
         testRegressions();
+        testOpenLedgerPrepare();
     }
 };
 
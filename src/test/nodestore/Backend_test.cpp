@@ -80,6 +80,27 @@ public:
                 fetchCopyOfBatch(*backend, &copy, batch);
                 BEAST_EXPECT(areBatchesEqual(batch, copy));
             }
+
+            {
+                // Read it back in one batch, along with keys never stored
+                auto const missing = createPredictableBatch(100, rng());
+                std::vector<uint256 const*> hashes;
+                for (auto const& object : batch)
+                    hashes.push_back(&object->getHash());
+                for (auto const& object : missing)
+                    hashes.push_back(&object->getHash());
+
+                auto const [objects, status] = backend->fetchBatch(hashes);
+                BEAST_EXPECT(status == ok);
+                if (BEAST_EXPECT(objects.size() == hashes.size()))
+                {
+                    for (std::size_t i = 0; i < batch.size(); ++i)
+                        BEAST_EXPECT(
+                            objects[i] && isSame(batch[i], objects[i]));
+                    for (std::size_t i = batch.size(); i < objects.size(); ++i)
+                        BEAST_EXPECT(!objects[i]);
+                }
+            }
         }
 
         {
@@ -25,8 +25,12 @@
 #include <xrpld/core/DatabaseCon.h>
 #include <xrpld/nodestore/DummyScheduler.h>
 #include <xrpld/nodestore/Manager.h>
+#include <xrpld/nodestore/detail/DatabaseRotatingImp.h>
 #include <xrpl/beast/utility/temp_dir.h>
 
+#include <atomic>
+#include <thread>
+
 namespace ripple {
 
 namespace NodeStore {
@@ -621,6 +625,194 @@ public:
 
     //--------------------------------------------------------------------------
 
+    void
+    testReadPool()
+    {
+        testcase("Read pool");
+
+        using namespace ripple::test;
+
+        auto makeSetup = [](beast::temp_dir const& dir,
+                            std::string const& journalMode,
+                            std::size_t readers) {
+            DatabaseCon::Setup::globalPragma.reset();
+            auto p = jtx::envconfig();
+            {
+                auto& section = p->section("sqlite");
+                section.set("journal_mode", journalMode);
+                section.set("read_connections", std::to_string(readers));
+            }
+            auto setup = setup_DatabaseCon(*p);
+            // Read sessions are only opened against regular DB files.
+            setup.standAlone = false;
+            setup.dataDir = dir.path();
+            return setup;
+        };
+
+        {
+            // WAL database with a read pool
+            beast::temp_dir dir;
+            auto const setup = makeSetup(dir, "wal", 2);
+            BEAST_EXPECT(setup.readConnections == 2);
+
+            DatabaseCon db(
+                setup, TxDBName, TxDBPragma, TxDBInit, setup.readConnections);
+            BEAST_EXPECT(db.readStats().sessions == 2);
+
+            // Databases that don't ask for a pool never open one.
+            DatabaseCon lgr(setup, LgrDBName, LgrDBPragma, LgrDBInit);
+            BEAST_EXPECT(lgr.readStats().sessions == 0);
+
+            *db.checkoutDb()
+                << "INSERT INTO Transactions (TransID, LedgerSeq) "
+                   "VALUES ('ABCD', 7);";
+
+            {
+                // Both sessions can be held at the same time, and both
+                // observe the committed write.
+                auto r1 = db.checkoutReadDb();
+                auto r2 = db.checkoutReadDb();
+                BEAST_EXPECT(r1.get() != r2.get());
+
+                for (auto* session : {r1.get(), r2.get()})
+                {
+                    std::uint64_t seq = 0;
+                    *session << "SELECT LedgerSeq FROM Transactions "
+                                "WHERE TransID = 'ABCD';",
+                        soci::into(seq);
+                    BEAST_EXPECT(seq == 7);
+                }
+            }
+
+            // Read sessions refuse to write.
+            try
+            {
+                *db.checkoutReadDb() << "DELETE FROM Transactions;";
+                fail();
+            }
+            catch (std::exception const&)
+            {
+                pass();
+            }
+
+            auto const stats = db.readStats();
+            BEAST_EXPECT(stats.checkouts == 3);
+            BEAST_EXPECT(stats.waits == 0);
+        }
+        {
+            // Without a write-ahead log readers would block on the writer,
+            // so no pool is created and reads use the main session.
+            beast::temp_dir dir;
+            DatabaseCon db(
+                makeSetup(dir, "delete", 2), TxDBName, TxDBPragma, TxDBInit, 2);
+            BEAST_EXPECT(db.readStats().sessions == 0);
+            BEAST_EXPECT(db.checkoutReadDb().get() == db.checkoutDb().get());
+            BEAST_EXPECT(db.readStats().checkouts == 0);
+        }
+
+        DatabaseCon::Setup::globalPragma.reset();
+    }
+
+    //--------------------------------------------------------------------------
+
+    void
+    testMigrateArchive(std::int64_t const seedValue)
+    {
+        testcase("migrate a NuDB archive while fetching");
+
+        DummyScheduler scheduler;
+        beast::temp_dir writableDir;
+        beast::temp_dir archiveDir;
+
+        auto makeBackend = [&](std::string const& type,
+                               std::string const& path) {
+            Section params;
+            params.set("type", type);
+            params.set("path", path);
+            std::shared_ptr<Backend> backend =
+                Manager::instance().make_Backend(
+                    params, megabytes(4), scheduler, journal_);
+            backend->open();
+            return backend;
+        };
+
+        // Enough objects for several batches to be migrated
+        auto const batch = createPredictableBatch(
+            3 * batchWritePreallocationSize + 10, seedValue);
+
+        // Write the archive, and close it so that everything is on disk
+        storeBatch(*makeBackend("nudb", archiveDir.path()), batch);
+
+        auto const archive = makeBackend("nudb", archiveDir.path());
+        auto const cold = makeBackend("memory", archiveDir.file("cold"));
+        DatabaseRotatingImp rotating(
+            scheduler,
+            2,
+            makeBackend("nudb", writableDir.path()),
+            archive,
+            cold,
+            Section{},
+            journal_);
+        Database& db = rotating;
+
+        // Fetch from another thread for as long as the migration runs
+        std::atomic<bool> done = false;
+        std::atomic<std::size_t> fetched = 0;
+        std::atomic<std::size_t> missed = 0;
+        std::thread reader([&]() {
+            for (std::size_t i = 0; !done; i = (i + 1) % batch.size())
+            {
+                try
+                {
+                    if (db.fetchNodeObject(batch[i]->getHash()))
+                        ++fetched;
+                    else
+                        ++missed;
+                }
+                catch (std::exception const&)
+                {
+                    ++missed;
+                }
+            }
+        });
+
+        // The archive also serves fetches between batches
+        std::size_t calls = 0;
+        auto const migrated = rotating.migrateArchive([&]() {
+            ++calls;
+            for (auto const& object : batch)
+            {
+                if (!db.fetchNodeObject(object->getHash()))
+                    return false;
+            }
+            return true;
+        });
+        done = true;
+        reader.join();
+
+        BEAST_EXPECT(migrated == batch.size());
+        BEAST_EXPECT(calls == 3);
+        BEAST_EXPECT(missed == 0);
+        log << fetched << " fetches during the migration" << std::endl;
+
+        // Everything is in the cold backend
+        {
+            Batch copy;
+            fetchCopyOfBatch(*cold, &copy, batch);
+            BEAST_EXPECT(areBatchesEqual(batch, copy));
+        }
+
+        // A migration stopped early leaves the archive open
+        BEAST_EXPECT(!rotating.migrateArchive([]() { return false; }));
+        {
+            Batch copy;
+            fetchCopyOfBatch(*archive, &copy, batch);
+            BEAST_EXPECT(areBatchesEqual(batch, copy));
+        }
+    }
+
+    //--------------------------------------------------------------------------
+
     void
     run() override
     {
@@ -628,6 +820,10 @@ public:
 
         testConfig();
 
+        testReadPool();
+
+        testMigrateArchive(seedValue);
+
         testNodeStore("memory", false, seedValue);
 
         // Persistent backend tests
@@ -22,6 +22,11 @@
 #include <xrpl/beast/unit_test.h>
 #include <xrpl/protocol/STAmount.h>
 
+#include <chrono>
+#include <limits>
+#include <optional>
+#include <vector>
+
 namespace ripple {
 
 class STAmount_test : public beast::unit_test::suite
@@ -673,6 +678,145 @@ public:
 
     //--------------------------------------------------------------------------
 
+    // The mantissa and exponent which canonicalize produced, one digit at a
+    // time, before it scaled in a single step; nullopt if it threw.
+    static std::optional<std::pair<std::uint64_t, int>>
+    legacyCanonical(std::uint64_t value, int offset)
+    {
+        if (value == 0)
+            return std::make_pair(std::uint64_t(0), -100);
+
+        while ((value < STAmount::cMinValue) && (offset > STAmount::cMinOffset))
+        {
+            value *= 10;
+            --offset;
+        }
+
+        while (value > STAmount::cMaxValue)
+        {
+            if (offset >= STAmount::cMaxOffset)
+                return std::nullopt;
+            value /= 10;
+            ++offset;
+        }
+
+        if ((offset < STAmount::cMinOffset) || (value < STAmount::cMinValue))
+            return std::make_pair(std::uint64_t(0), -100);
+
+        if (offset > STAmount::cMaxOffset)
+            return std::nullopt;
+
+        return std::make_pair(value, offset);
+    }
+
+    void
+    testCanonicalize()
+    {
+        testcase("canonicalize");
+
+        NumberSO stNumberSO{false};
+        Issue const usd{Currency(0x5553440000000000), AccountID(0x4985601)};
+
+        auto check = [&](std::uint64_t value, int offset) {
+            auto const expected = legacyCanonical(value, offset);
+            try
+            {
+                STAmount const amount(usd, value, offset);
+                if (!BEAST_EXPECT(expected))
+                    return;
+                BEAST_EXPECT(amount.mantissa() == expected->first);
+                BEAST_EXPECT(amount.exponent() == expected->second);
+            }
+            catch (std::runtime_error const&)
+            {
+                BEAST_EXPECT(!expected);
+            }
+        };
+
+        // Every digit count, at its boundaries and in between, across and
+        // just beyond the range of exponents.
+        std::uint64_t low = 1;
+        for (int digits = 1; digits <= 20; ++digits, low *= 10)
+        {
+            std::uint64_t const high = digits == 20
+                ? std::numeric_limits<std::uint64_t>::max()
+                : low * 10 - 1;
+
+            for (int offset = -115; offset <= 100; ++offset)
+            {
+                check(low, offset);
+                check(high, offset);
+                check(rand_int(low, high), offset);
+            }
+        }
+    }
+
+    // The native operand of multiply, divide, mulRound and divRound is
+    // scaled to an IOU mantissa; the result must be exactly as if the same
+    // value had been given as an IOU.
+    void
+    testNativeOperands()
+    {
+        testcase("native operands");
+
+        NumberSO stNumberSO{false};
+        Issue const usd{Currency(0x5553440000000000), AccountID(0x4985601)};
+
+        auto same = [](STAmount const& a, STAmount const& b) {
+            return a.mantissa() == b.mantissa() &&
+                a.exponent() == b.exponent() && a.negative() == b.negative();
+        };
+
+        auto check = [&](std::uint64_t drops, STAmount const& iou) {
+            STAmount const native(drops);
+            STAmount const asIOU(usd, drops);
+
+            BEAST_EXPECT(same(
+                multiply(native, iou, usd), multiply(asIOU, iou, usd)));
+            BEAST_EXPECT(same(
+                multiply(iou, native, usd), multiply(iou, asIOU, usd)));
+            BEAST_EXPECT(
+                same(divide(native, iou, usd), divide(asIOU, iou, usd)));
+            BEAST_EXPECT(
+                same(divide(iou, native, usd), divide(iou, asIOU, usd)));
+
+            for (bool const roundUp : {false, true})
+            {
+                BEAST_EXPECT(same(
+                    mulRound(native, iou, usd, roundUp),
+                    mulRound(asIOU, iou, usd, roundUp)));
+                BEAST_EXPECT(same(
+                    mulRoundStrict(iou, native, usd, roundUp),
+                    mulRoundStrict(iou, asIOU, usd, roundUp)));
+                BEAST_EXPECT(same(
+                    divRound(native, iou, usd, roundUp),
+                    divRound(asIOU, iou, usd, roundUp)));
+                BEAST_EXPECT(same(
+                    divRoundStrict(iou, native, usd, roundUp),
+                    divRoundStrict(iou, asIOU, usd, roundUp)));
+            }
+        };
+
+        // Up to the largest native value which is still an IOU mantissa.
+        for (std::uint64_t low = 1; low < STAmount::cMinValue * 10; low *= 10)
+        {
+            for (int i = 0; i < 20; ++i)
+            {
+                STAmount const iou(
+                    usd,
+                    rand_int(STAmount::cMinValue, STAmount::cMaxValue),
+                    rand_int(-20, 20),
+                    rand_int(1) == 1);
+
+                check(low, iou);
+                check(low * 10 - 1, iou);
+                check(rand_int(low, low * 10 - 1), iou);
+            }
+        }
+    }
+
+    //--------------------------------------------------------------------------
+
     void
     run() override
     {
@@ -684,9 +828,80 @@ public:
         testRounding();
         testConvertXRP();
         testConvertIOU();
+        testCanonicalize();
+        testNativeOperands();
     }
 };
 
 BEAST_DEFINE_TESTSUITE(STAmount, ripple_data, ripple);
 
+//------------------------------------------------------------------------------
+
+class STAmountBench_test : public beast::unit_test::suite
+{
+public:
+    void
+    run() override
+    {
+        testcase("multiply and divide");
+
+        NumberSO stNumberSO{false};
+        Issue const usd{Currency(0x5553440000000000), AccountID(0x4985601)};
+
+        std::size_t const count = 100000;
+        std::vector<std::pair<STAmount, STAmount>> operands;
+        operands.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto randomAmount = [&]() {
+                if (rand_int(3) == 0)
+                    return STAmount(rand_int<std::uint64_t>(1, 100000000000));
+                return STAmount(
+                    usd,
+                    rand_int(STAmount::cMinValue, STAmount::cMaxValue),
+                    rand_int(-20, 20));
+            };
+            operands.emplace_back(randomAmount(), randomAmount());
+        }
+
+        auto time = [&](char const* name, auto&& f) {
+            using clock = std::chrono::steady_clock;
+            std::uint64_t sink = 0;
+            auto const start = clock::now();
+            for (auto const& [a, b] : operands)
+                sink += f(a, b).mantissa();
+            auto const elapsed = clock::now() - start;
+            log << name << ": "
+                << std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       elapsed)
+                        .count() /
+                    count
+                << " ns/op (" << sink % 10 << ")" << std::endl;
+        };
+
+        time("multiply", [&](STAmount const& a, STAmount const& b) {
+            return multiply(a, b, usd);
+        });
+        time("divide", [&](STAmount const& a, STAmount const& b) {
+            return divide(a, b, usd);
+        });
+        time("mulRound", [&](STAmount const& a, STAmount const& b) {
+            return mulRound(a, b, usd, true);
+        });
+        time("divRound", [&](STAmount const& a, STAmount const& b) {
+            return divRound(a, b, usd, false);
+        });
+        time("mulRoundStrict", [&](STAmount const& a, STAmount const& b) {
+            return mulRoundStrict(a, b, usd, true);
+        });
+        time("divRoundStrict", [&](STAmount const& a, STAmount const& b) {
+            return divRoundStrict(a, b, usd, false);
+        });
+
+        pass();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(STAmountBench, ripple_data, ripple);
+
 }  // namespace ripple
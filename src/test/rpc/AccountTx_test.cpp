@@ -754,6 +754,70 @@ class AccountTx_test : public beast::unit_test::suite
         }
     }
 
+    void
+    testPaging()
+    {
+        testcase("Paging");
+
+        // Page through an account's history with a small limit, in both
+        // directions, and verify that resuming from each marker neither
+        // skips nor repeats transactions, including when a page boundary
+        // falls in the middle of a ledger.
+        using namespace test::jtx;
+
+        Env env(*this);
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+
+        env.fund(XRP(10000), alice, bob);
+        env.close();
+
+        for (int i = 0; i < 5; ++i)
+        {
+            for (int j = 0; j < 3; ++j)
+                env(pay(alice, bob, XRP(1)));
+            env.close();
+        }
+
+        auto getHashes = [&env, &alice](bool forward, std::uint32_t limit) {
+            std::vector<std::string> hashes;
+            Json::Value params;
+            params[jss::account] = alice.human();
+            params[jss::ledger_index_min] = -1;
+            params[jss::ledger_index_max] = -1;
+            params[jss::forward] = forward;
+            if (limit != 0)
+                params[jss::limit] = limit;
+
+            for (int pages = 0; pages < 100; ++pages)
+            {
+                auto const result =
+                    env.rpc("json", "account_tx", to_string(params));
+                if (result[jss::result][jss::status] != "success")
+                    break;
+                for (auto const& tx : result[jss::result][jss::transactions])
+                    hashes.push_back(tx[jss::tx][jss::hash].asString());
+                if (!result[jss::result].isMember(jss::marker))
+                    break;
+                params[jss::marker] = result[jss::result][jss::marker];
+            }
+            return hashes;
+        };
+
+        auto const all = getHashes(true, 0);
+        // Two transactions to fund alice plus the fifteen payments.
+        BEAST_EXPECT(all.size() == 17);
+
+        for (std::uint32_t const limit : {1u, 2u, 4u})
+        {
+            BEAST_EXPECT(getHashes(true, limit) == all);
+
+            auto backward = getHashes(false, limit);
+            std::reverse(backward.begin(), backward.end());
+            BEAST_EXPECT(backward == all);
+        }
+    }
+
 public:
     void
     run() override
@@ -762,6 +826,7 @@ public:
             std::bind_front(&AccountTx_test::testParameters, this));
         testContents();
         testAccountDelete();
+        testPaging();
     }
 };
 BEAST_DEFINE_TESTSUITE(AccountTx, rpc, ripple);
@@ -1709,6 +1709,57 @@ public:
             (asAdmin ? RPC::Tuning::bookOffers.rdefault : 0u));
     }
 
+    void
+    testBookOfferCache()
+    {
+        testcase("BookOffer Cache");
+        using namespace jtx;
+        Env env{*this};
+        Account gw{"gw"};
+        Account alice{"alice"};
+        auto USD = gw["USD"];
+
+        env.fund(XRP(10000), gw, alice);
+        env.trust(USD(1000), alice);
+        env(pay(gw, alice, USD(100)));
+        env(offer(alice, XRP(100), USD(50)));
+        env.close();
+
+        Json::Value jvParams;
+        jvParams[jss::ledger_index] = "validated";
+        jvParams[jss::taker_pays][jss::currency] = "XRP";
+        jvParams[jss::taker_gets][jss::currency] = "USD";
+        jvParams[jss::taker_gets][jss::issuer] = gw.human();
+
+        auto getOffers = [&]() {
+            return env.rpc("json", "book_offers", to_string(jvParams))
+                [jss::result][jss::offers];
+        };
+
+        // Asking twice for the same ledger is answered from the cache.
+        auto const first = getOffers();
+        auto const second = getOffers();
+        BEAST_EXPECT(first.size() == 1);
+        BEAST_EXPECT(first == second);
+        BEAST_EXPECT(!first[0u].isMember(jss::taker_gets_funded));
+        BEAST_EXPECT(
+            env.rpc("get_counts")[jss::result][jss::book_page_hit_rate]
+                .asDouble() > 0);
+
+        // A change to the owner's funds in a later ledger is reflected,
+        // even though the offer itself did not change.
+        env(pay(alice, gw, USD(80)));
+        env.close();
+
+        auto const third = getOffers();
+        if (BEAST_EXPECT(third.size() == 1))
+        {
+            BEAST_EXPECT(third[0u][jss::owner_funds] == "20");
+            BEAST_EXPECT(
+                third[0u][jss::taker_gets_funded][jss::value] == "20");
+        }
+    }
+
     void
     run() override
     {
@@ -1726,6 +1777,7 @@ public:
         testBookOfferErrors();
         testBookOfferLimits(true);
         testBookOfferLimits(false);
+        testBookOfferCache();
     }
 };
 
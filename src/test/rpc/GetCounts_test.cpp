@@ -50,6 +50,7 @@ class GetCounts_test : public beast::unit_test::suite
             BEAST_EXPECT(
                 result.isMember(jss::dbKBTotal) &&
                 result[jss::dbKBTotal].asInt() > 0);
+            BEAST_EXPECT(result.isMember(jss::pending_saves));
         }
 
         // create some transactions
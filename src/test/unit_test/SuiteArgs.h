@@ -0,0 +1,107 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef TEST_UNIT_TEST_SUITE_ARGS_H
+#define TEST_UNIT_TEST_SUITE_ARGS_H
+
+#include <xrpl/basics/contract.h>
+#include <xrpl/beast/core/LexicalCast.h>
+
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace ripple {
+namespace test {
+
+/** The parameters passed to a suite, as comma separated key=value pairs.
+
+    Each parameter the suite knows is read with get(), then done() rejects
+    any left over, so a misspelt key is not silently ignored.
+
+    @code
+        SuiteArgs args(arg());
+        args.get("peers", peers);
+        args.get("delay", delay, 0);
+        args.done();
+    @endcode
+*/
+class SuiteArgs
+{
+    std::map<std::string, std::string> values_;
+
+public:
+    explicit SuiteArgs(std::string const& arg)
+    {
+        if (arg.empty())
+            return;
+
+        std::string::size_type start = 0;
+        for (;;)
+        {
+            auto const end = arg.find(',', start);
+            auto const item = arg.substr(start, end - start);
+            auto const eq = item.find('=');
+            if (eq == std::string::npos || eq == 0)
+                Throw<std::runtime_error>("invalid parameter " + item);
+            if (!values_.emplace(item.substr(0, eq), item.substr(eq + 1))
+                     .second)
+                Throw<std::runtime_error>("duplicate parameter " + item);
+            if (end == std::string::npos)
+                break;
+            start = end + 1;
+        }
+    }
+
+    /** Read a numeric parameter, if it was passed.
+
+        @param key The name of the parameter.
+        @param value Set to the value passed, and left alone otherwise.
+        @param min The smallest value allowed.
+    */
+    template <class T>
+    void
+    get(std::string const& key, T& value, std::type_identity_t<T> min = 1)
+    {
+        auto const it = values_.find(key);
+        if (it == values_.end())
+            return;
+
+        T parsed;
+        if (!beast::lexicalCastChecked(parsed, it->second) || parsed < min)
+            Throw<std::runtime_error>("invalid value for " + key);
+        value = parsed;
+        values_.erase(it);
+    }
+
+    /** Throw if a parameter was passed which was not read. */
+    void
+    done() const
+    {
+        if (!values_.empty())
+            Throw<std::runtime_error>(
+                "unknown parameter " + values_.begin()->first);
+    }
+};
+
+}  // namespace test
+}  // namespace ripple
+
+#endif
@@ -26,6 +26,7 @@
 #include <xrpld/app/ledger/LedgerMaster.h>
 #include <xrpld/app/ledger/LocalTxs.h>
 #include <xrpld/app/ledger/OpenLedger.h>
+#include <xrpld/app/main/CollectorManager.h>
 #include <xrpld/app/misc/AmendmentTable.h>
 #include <xrpld/app/misc/HashRouter.h>
 #include <xrpld/app/misc/LoadFeeTrack.h>
@@ -94,6 +95,12 @@ RCLConsensus::Adaptor::Adaptor(
 {
     assert(valCookie_ != 0);
 
+    auto const& group(app_.getCollectorManager().group("consensus"));
+    establishTime_ = group->make_event("establish");
+    buildTime_ = group->make_event("build");
+    acceptTime_ = group->make_event("accept");
+    closeTimeSpread_ = group->make_event("close_time_spread");
+
     JLOG(j_.info()) << "Consensus engine started (cookie: " +
             std::to_string(valCookie_) + ")";
 
@@ -455,6 +462,10 @@ RCLConsensus::Adaptor::doAccept(
     ConsensusMode const& mode,
     Json::Value&& consensusJson)
 {
+    using namespace std::chrono;
+    auto const acceptStart = steady_clock::now();
+    auto timing = result.timing;
+
     prevProposers_ = result.proposers;
     prevRoundTime_ = result.roundTime.read();
 
@@ -515,6 +526,7 @@ RCLConsensus::Adaptor::doAccept(
         }
     }
 
+    auto const buildStart = steady_clock::now();
     auto built = buildLCL(
         prevLedger,
         retriableTxs,
@@ -523,6 +535,9 @@ RCLConsensus::Adaptor::doAccept(
         closeResolution,
         result.roundTime.read(),
         failed);
+    timing.seq = built.seq();
+    timing.build =
+        duration_cast<milliseconds>(steady_clock::now() - buildStart);
 
     auto const newLCLHash = built.id();
     JLOG(j_.debug()) << "Built ledger #" << built.seq() << ": " << newLCLHash;
@@ -634,23 +649,27 @@ RCLConsensus::Adaptor::doAccept(
             }
         }
 
-        // Build new open ledger
-        std::unique_lock lock{app_.getMasterMutex(), std::defer_lock};
-        std::unique_lock sl{ledgerMaster_.peekMutex(), std::defer_lock};
-        std::lock(lock, sl);
-
         auto const lastVal = ledgerMaster_.getValidatedLedger();
         std::optional<Rules> rules;
         if (lastVal)
             rules = makeRulesGivenLedger(*lastVal, app_.config().features);
         else
             rules.emplace(app_.config().features);
+
+        // Replay the open ledger onto the new one before taking the
+        // locks, so new transactions don't wait for all of it.
+        auto prepared = app_.openLedger().prepare(
+            app_, *rules, built.ledger_, anyDisputes, retriableTxs, tapNONE);
+
+        // Build new open ledger
+        std::unique_lock lock{app_.getMasterMutex(), std::defer_lock};
+        std::unique_lock sl{ledgerMaster_.peekMutex(), std::defer_lock};
+        std::lock(lock, sl);
+
         app_.openLedger().accept(
             app_,
-            *rules,
-            built.ledger_,
+            std::move(prepared),
             localTxs_.getTxSet(),
-            anyDisputes,
             retriableTxs,
             tapNONE,
             "consensus",
@@ -712,6 +731,15 @@ RCLConsensus::Adaptor::doAccept(
 
         app_.timeKeeper().adjustCloseTime(offset);
     }
+
+    timing.accept =
+        duration_cast<milliseconds>(steady_clock::now() - acceptStart);
+    establishTime_.notify(timing.establish);
+    buildTime_.notify(timing.build);
+    acceptTime_.notify(timing.accept);
+    closeTimeSpread_.notify(timing.closeTimeSpread);
+    JLOG(j_.debug()) << "Round timing: " << Json::Compact(timing.getJson());
+    timing_.add(timing);
 }
 
 void
@@ -915,6 +943,7 @@ RCLConsensus::getJson(bool full) const
         ret = consensus_.getJson(full);
     }
     ret["validating"] = adaptor_.validating();
+    ret["round_timing"] = adaptor_.timing().getJson(full ? 16 : 0);
     return ret;
 }
 
@@ -32,6 +32,7 @@
 #include <xrpld/shamap/SHAMap.h>
 #include <xrpl/basics/CountedObject.h>
 #include <xrpl/basics/Log.h>
+#include <xrpl/beast/insight/Event.h>
 #include <xrpl/beast/utility/Journal.h>
 #include <xrpl/protocol/RippleLedgerHash.h>
 #include <xrpl/protocol/STValidation.h>
@@ -87,6 +88,13 @@ class RCLConsensus
         RCLCensorshipDetector<TxID, LedgerIndex> censorshipDetector_;
         NegativeUNLVote nUnlVote_;
 
+        // Where the time of recent rounds went
+        ConsensusTimingHistory timing_;
+        beast::insight::Event establishTime_;
+        beast::insight::Event buildTime_;
+        beast::insight::Event acceptTime_;
+        beast::insight::Event closeTimeSpread_;
+
     public:
         using Ledger_t = RCLCxLedger;
         using NodeID_t = NodeID;
@@ -123,6 +131,12 @@ class RCLConsensus
             return prevRoundTime_;
         }
 
+        ConsensusTimingHistory const&
+        timing() const
+        {
+            return timing_;
+        }
+
         ConsensusMode
         mode() const
         {
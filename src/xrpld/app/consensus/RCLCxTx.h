@@ -167,12 +167,29 @@ public:
     */
     std::map<Tx::ID, bool>
     compare(RCLTxSet const& j) const
+    {
+        bool complete;
+        return compare(j, complete);
+    }
+
+    /** Find transactions not in common between this and another transaction
+       set.
+
+        @param j The set to compare with
+        @param complete Set to false if the sets differ by too many
+                        transactions for all of them to be returned.
+        @return Map of transactions in this set and `j` but not both. The key
+                is the transaction ID and the value is a bool of the transaction
+                exists in this set.
+    */
+    std::map<Tx::ID, bool>
+    compare(RCLTxSet const& j, bool& complete) const
     {
         SHAMap::Delta delta;
 
         // Bound the work we do in case of a malicious
         // map_ from a trusted validator
-        map_->compare(*(j.map_), delta, 65536);
+        complete = map_->compare(*(j.map_), delta, 65536);
 
         std::map<uint256, bool> ret;
         for (auto const& [k, v] : delta)
@@ -21,12 +21,12 @@
 #define RIPPLE_APP_LEDGER_INBOUNDLEDGER_H_INCLUDED
 
 #include <xrpld/app/ledger/Ledger.h>
+#include <xrpld/app/ledger/detail/PeerFetchWindows.h>
 #include <xrpld/app/ledger/detail/TimeoutCounter.h>
 #include <xrpld/app/main/Application.h>
 #include <xrpld/overlay/PeerSet.h>
 #include <xrpl/basics/CountedObject.h>
 #include <mutex>
-#include <set>
 #include <utility>
 
 namespace ripple {
@@ -121,9 +121,17 @@ public:
 private:
     enum class TriggerReason { added, reply, timeout };
 
-    void
-    filterNodes(
-        std::vector<std::pair<SHAMapNodeID, uint256>>& nodes,
+    std::vector<std::shared_ptr<Peer>>
+    fetchPeers(std::shared_ptr<Peer> const& peer, TriggerReason reason) const;
+
+    int
+    fetchWanted(std::vector<std::shared_ptr<Peer>> const& peers) const;
+
+    bool
+    requestNodes(
+        protocol::TMGetLedger& tmGL,
+        std::vector<std::pair<SHAMapNodeID, uint256>> const& nodes,
+        std::vector<std::shared_ptr<Peer>> const& peers,
         TriggerReason reason);
 
     void
@@ -183,7 +191,8 @@ private:
     std::uint32_t mSeq;
     Reason const mReason;
 
-    std::set<uint256> mRecentNodes;
+    // Which peers are asked for which nodes, and how many at once
+    PeerFetchWindows mFetchWindows;
 
     SHAMapAddNode mStats;
 
@@ -986,6 +986,65 @@ saveValidatedLedger(
     return res;
 }
 
+/** Save the ledgers queued in PendingSaves, several at a time.
+
+    Each batch is written to the databases with a single SQL transaction,
+    in ascending sequence order. Ledgers that were saved synchronously in the
+    meantime are skipped.
+
+    @param current Whether to drain the queue of current ledgers or the
+                   queue of history ledgers.
+    @return false if any batch failed to save.
+*/
+static bool
+saveQueuedLedgers(Application& app, bool current)
+{
+    // Bounds how long the databases are locked for a single batch.
+    constexpr std::size_t maxBatchSize = 16;
+
+    auto const db = dynamic_cast<SQLiteDatabase*>(&app.getRelationalDatabase());
+    if (!db)
+        Throw<std::runtime_error>("Failed to get relational database");
+
+    bool res = true;
+    auto& pendingSaves = app.pendingSaves();
+    for (auto queued = pendingSaves.dequeue(current, maxBatchSize);
+         !queued.empty();
+         queued = pendingSaves.dequeue(current, maxBatchSize))
+    {
+        std::vector<std::shared_ptr<Ledger const>> batch;
+        batch.reserve(queued.size());
+        for (auto& ledger : queued)
+        {
+            if (pendingSaves.startWork(ledger->info().seq))
+                batch.push_back(std::move(ledger));
+        }
+
+        if (batch.empty())
+            continue;
+
+        JLOG(app.journal("Ledger").debug())
+            << "Saving " << batch.size() << " ledgers from "
+            << batch.front()->info().seq << " to "
+            << batch.back()->info().seq;
+
+        if (!db->saveValidatedLedgers(batch, current))
+        {
+            JLOG(app.journal("Ledger").warn())
+                << "Failed to save ledgers from " << batch.front()->info().seq
+                << " to " << batch.back()->info().seq;
+            res = false;
+        }
+
+        // Clients can now trust the database for
+        // information about these ledger sequences.
+        for (auto const& ledger : batch)
+            pendingSaves.finishWork(ledger->info().seq);
+    }
+
+    return res;
+}
+
 /** Save, or arrange to save, a fully-validated ledger
     Returns false on error
 */
@@ -1021,16 +1080,23 @@ pendSaveValidated(
         return true;
     }
 
-    // See if we can use the JobQueue.
-    if (!isSynchronous &&
-        app.getJobQueue().addJob(
-            isCurrent ? jtPUBLEDGER : jtPUBOLDLEDGER,
-            std::to_string(ledger->seq()),
-            [&app, ledger, isCurrent]() {
-                saveValidatedLedger(app, ledger, isCurrent);
-            }))
+    // See if we can use the JobQueue. Asynchronous saves are queued and
+    // written in batches by one job per queue.
+    if (!isSynchronous)
     {
-        return true;
+        if (!app.pendingSaves().enqueue(ledger->info().seq, ledger, isCurrent))
+            return true;
+
+        if (app.getJobQueue().addJob(
+                isCurrent ? jtPUBLEDGER : jtPUBOLDLEDGER,
+                std::to_string(ledger->seq()),
+                [&app, isCurrent]() { saveQueuedLedgers(app, isCurrent); }))
+        {
+            return true;
+        }
+
+        // The JobQueue won't do the Job. Write the queue synchronously.
+        return saveQueuedLedgers(app, isCurrent);
     }
 
     // The JobQueue won't do the Job.  Do the save synchronously.
@@ -26,6 +26,7 @@
 #include <xrpld/app/ledger/LedgerHistory.h>
 #include <xrpld/app/ledger/LedgerHolder.h>
 #include <xrpld/app/ledger/LedgerReplay.h>
+#include <xrpld/app/ledger/detail/HistoryBackfill.h>
 #include <xrpld/app/main/Application.h>
 #include <xrpld/app/misc/CanonicalTXSet.h>
 #include <xrpl/basics/RangeSet.h>
@@ -261,6 +262,10 @@ public:
     std::size_t
     getFetchPackCacheSize() const;
 
+    /** Progress filling gaps in history. Null if there was none. */
+    Json::Value
+    getBackfillJson();
+
     //! Whether we have ever fully validated a ledger.
     bool
     haveValidated()
@@ -299,6 +304,15 @@ private:
         bool& progress,
         InboundLedger::Reason reason,
         std::unique_lock<std::recursive_mutex>&);
+    // The earliest ledger to fill below a missing ledger
+    LedgerIndex
+    backfillFloor(LedgerIndex missing);
+    // Start acquiring the ledgers below a missing ledger
+    void
+    backfill(
+        LedgerIndex missing,
+        LedgerIndex floor,
+        InboundLedger::Reason reason);
     // Try to publish ledgers, acquire missing ledgers.  Always called with
     // m_mutex locked.  The passed lock is a reminder to callers.
     void
@@ -382,6 +396,8 @@ private:
 
     std::uint32_t fetch_seq_{0};
 
+    HistoryBackfill backfill_;
+
     // Try to keep a validator from switching from test to live network
     // without first wiping the database.
     LedgerIndex const max_ledger_difference_{1000000};
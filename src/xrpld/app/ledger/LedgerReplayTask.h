@@ -24,6 +24,7 @@
 #include <xrpld/app/ledger/detail/TimeoutCounter.h>
 #include <xrpld/app/main/Application.h>
 
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -50,6 +51,8 @@ public:
         InboundLedger::Reason reason_;
         uint256 finishHash_;
         std::uint32_t totalLedgers_;  // including the start and the finish
+        // ledgers replayed by the tasks chained below, including the start
+        std::uint32_t ledgersBelow_ = 0;
 
         // to be updated
         std::uint32_t finishSeq_ = 0;
@@ -87,6 +90,13 @@ public:
         /** check if this task can be merged into an existing task */
         bool
         canMergeInto(TaskParameter const& existingTask) const;
+
+        /** number of ledgers replayed by the task and the chain below it */
+        std::uint32_t
+        coverage() const
+        {
+            return totalLedgers_ + (ledgersBelow_ ? ledgersBelow_ - 1 : 0);
+        }
     };
 
     /**
@@ -129,6 +139,17 @@ public:
     bool
     finished() const;
 
+    /** return the finish ledger if the task completed, nullptr otherwise */
+    std::shared_ptr<Ledger const>
+    finishLedger() const;
+
+    /**
+     * Chain a task above this one, which starts with this task's finish ledger
+     * @param above  the task to hand the finish ledger to
+     */
+    void
+    setAbove(std::weak_ptr<LedgerReplayTask> const& above);
+
 private:
     void
     onTimer(bool progress, ScopedLockType& sl) override;
@@ -155,6 +176,14 @@ private:
     void
     deltaReady(uint256 const& deltaHash);
 
+    /**
+     * Notify this task (by the task chained below) that the start ledger is
+     * built
+     * @param ledger  the start ledger
+     */
+    void
+    startReady(std::shared_ptr<Ledger const> const& ledger);
+
     /**
      * Trigger another round
      * @param sl  lock. this function must be called with the lock
@@ -177,6 +206,12 @@ private:
     std::shared_ptr<Ledger const> parent_ = {};
     uint32_t deltaToBuild_ = 0;  // should not build until have parent
     std::vector<std::shared_ptr<LedgerDeltaAcquire>> deltas_;
+    // set while a job to build ledgers is queued and has not started
+    std::atomic<bool> buildQueued_{false};
+    // the task building the start ledger, and the tasks waiting for the finish
+    std::weak_ptr<LedgerReplayTask> below_;
+    bool waitForStart_ = false;
+    std::vector<std::weak_ptr<LedgerReplayTask>> above_;
 
     friend class test::LedgerReplayClient;
 };
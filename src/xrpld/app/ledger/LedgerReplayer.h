@@ -25,6 +25,7 @@
 #include <xrpld/app/main/Application.h>
 #include <xrpl/beast/utility/Journal.h>
 
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -57,11 +58,16 @@ auto constexpr MAX_NO_FEATURE_PEER_COUNT = 2;
 auto constexpr SUB_TASK_FALLBACK_TIMEOUT = std::chrono::milliseconds{1000};
 
 // for LedgerReplayer to limit the number of LedgerReplayTask
-std::uint32_t constexpr MAX_TASKS = 10;
+std::uint32_t constexpr MAX_TASKS = 32;
 
 // for LedgerReplayer to limit the number of ledgers to replay in one task
 std::uint32_t constexpr MAX_TASK_SIZE = 256;
 
+// to limit the number of ledgers to replay in one request. Longer requests
+// are split in a chain of tasks, each starting with the ledger the task
+// before it finishes with.
+std::uint32_t constexpr MAX_REPLAY_LEDGERS = 4096;
+
 // to limit the number of LedgerReplay related jobs in JobQueue
 std::uint32_t constexpr MAX_QUEUED_TASKS = 100;
 }  // namespace LedgerReplayParameters
@@ -79,19 +85,67 @@ public:
 
     ~LedgerReplayer();
 
+    /** Counts of the ways the server caught up with the network. */
+    struct CatchUpStats
+    {
+        /// Gaps replayed from ledger deltas, and the ledgers in them
+        std::uint64_t replays = 0;
+        std::uint64_t replayLedgers = 0;
+        /// Gaps skipped because they were too long to replay
+        std::uint64_t skips = 0;
+        std::uint64_t skipLedgers = 0;
+        /// Ledgers built by applying deltas, and the time it took
+        std::uint64_t built = 0;
+        std::chrono::microseconds buildTime{};
+    };
+
     /**
      * Replay a range of ledgers
      * @param r  reason for the replay request
      * @param finishLedgerHash  hash of the last ledger
      * @param totalNumLedgers  total number of ledgers in the range, inclusive
-     * @note totalNumLedgers must > 0 && totalNumLedgers must <= 256
+     * @return  the task replaying the last ledgers of the range, nullptr if
+     *          the request was dropped or merged into a task with another
+     *          finish ledger
+     * @note totalNumLedgers must > 0 && totalNumLedgers must <= 4096
      */
-    void
+    std::shared_ptr<LedgerReplayTask>
     replay(
         InboundLedger::Reason r,
         uint256 const& finishLedgerHash,
         std::uint32_t totalNumLedgers);
 
+    /**
+     * Catch up by replaying a gap in the validated ledgers
+     * @param r  reason for the replay request
+     * @param finishLedgerHash  hash of the last ledger of the gap
+     * @param totalNumLedgers  number of ledgers in the gap, including the
+     *        ledger before it
+     */
+    void
+    catchUp(
+        InboundLedger::Reason r,
+        uint256 const& finishLedgerHash,
+        std::uint32_t totalNumLedgers);
+
+    /**
+     * Note that a gap was too long to replay, and was skipped
+     * @param numLedgers  number of ledgers skipped
+     */
+    void
+    onGapSkipped(std::uint32_t numLedgers);
+
+    /**
+     * Note that a task built a ledger from a delta
+     * @param elapsed  time spent building it
+     */
+    void
+    onLedgerBuilt(std::chrono::microseconds elapsed);
+
+    /** Returns the catch up counters since this object was created. */
+    CatchUpStats
+    getCatchUpStats() const;
+
     /** Create LedgerDeltaAcquire subtasks for the LedgerReplayTask task */
     void
     createDeltas(std::shared_ptr<LedgerReplayTask> task);
@@ -118,6 +172,14 @@ public:
         LedgerInfo const& info,
         std::map<std::uint32_t, std::shared_ptr<STTx const>>&& txns);
 
+    /**
+     * Check if a ledger delta is being acquired
+     * @param hash  hash of the ledger
+     * @return true if a TMReplayDeltaResponse for the ledger is wanted
+     */
+    bool
+    wantsReplayDelta(uint256 const& hash) const;
+
     /** Remove completed tasks */
     void
     sweep();
@@ -149,6 +211,9 @@ public:
 private:
     mutable std::mutex mtx_;
     std::vector<std::shared_ptr<LedgerReplayTask>> tasks_;
+    mutable std::mutex statsMtx_;
+    CatchUpStats stats_;
+    uint256 lastCatchUp_;
     hash_map<uint256, std::weak_ptr<LedgerDeltaAcquire>> deltas_;
     hash_map<uint256, std::weak_ptr<SkipListAcquire>> skipLists_;
 
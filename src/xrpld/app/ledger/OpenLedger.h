@@ -29,6 +29,8 @@
 #include <xrpl/basics/UnorderedContainers.h>
 #include <xrpl/beast/utility/Journal.h>
 #include <cassert>
+#include <chrono>
+#include <cstdint>
 #include <mutex>
 
 namespace ripple {
@@ -48,12 +50,35 @@ using OrderedTxs = CanonicalTXSet;
 /** Represents the open ledger. */
 class OpenLedger
 {
+public:
+    /** A new open view, built by prepare and published by accept. */
+    struct Prepared
+    {
+        std::shared_ptr<Ledger const> ledger;
+        std::shared_ptr<OpenView> view;
+        /// The open view whose transactions were replayed onto view
+        std::shared_ptr<OpenView const> snapshot;
+    };
+
+    /** Counts of the transactions replayed onto new open views. */
+    struct ReplayStats
+    {
+        /// Replayed by prepare, while modify was not blocked
+        std::uint64_t replayed = 0;
+        /// Replayed by accept, because they arrived after prepare
+        std::uint64_t replayedLocked = 0;
+        std::chrono::microseconds replayTime{};
+        std::chrono::microseconds replayLockedTime{};
+    };
+
 private:
     beast::Journal const j_;
     CachedSLEs& cache_;
     std::mutex mutable modify_mutex_;
     std::mutex mutable current_mutex_;
     std::shared_ptr<OpenView const> current_;
+    std::mutex mutable stats_mutex_;
+    ReplayStats stats_;
 
 public:
     /** Signature for modification functions.
@@ -170,14 +195,68 @@ public:
         std::string const& suffix = "",
         modify_type const& f = {});
 
+    /** Start building the open view for a new ledger.
+
+        Thread safety:
+            Can be called concurrently from any thread.
+            Does not block calls to modify.
+
+        Effects:
+
+            A new open view based on the accepted ledger
+            is created, and the list of retriable
+            transactions is optionally applied first
+            depending on the value of `retriesFirst`.
+
+            The transactions in a snapshot of the current
+            open view are applied to the new open view.
+
+        Most of the work of accepting a ledger is replaying
+        the open ledger, and this does it without holding any
+        lock a new transaction needs. Pass the result to accept
+        to finish, which only applies the transactions that
+        reached the open ledger after the snapshot.
+    */
+    Prepared
+    prepare(
+        Application& app,
+        Rules const& rules,
+        std::shared_ptr<Ledger const> const& ledger,
+        bool retriesFirst,
+        OrderedTxs& retries,
+        ApplyFlags flags);
+
+    /** Accept a new ledger, using an open view from prepare.
+
+        As above, except that the transactions already replayed
+        by prepare are not applied again.
+    */
+    void
+    accept(
+        Application& app,
+        Prepared prepared,
+        OrderedTxs const& locals,
+        OrderedTxs& retries,
+        ApplyFlags flags,
+        std::string const& suffix = "",
+        modify_type const& f = {});
+
+    /** Returns the replay counters since this object was created. */
+    ReplayStats
+    getReplayStats() const;
+
 private:
     /** Algorithm for applying transactions.
 
         This has the retry logic and ordering semantics
         used for consensus and building the open ledger.
+
+        @return The number of transactions from `txs` which
+                were applied, or tried, because `check` did
+                not already contain them.
     */
     template <class FwdRange>
-    static void
+    static std::size_t
     apply(
         Application& app,
         OpenView& view,
@@ -205,7 +284,7 @@ private:
 //------------------------------------------------------------------------------
 
 template <class FwdRange>
-void
+std::size_t
 OpenLedger::apply(
     Application& app,
     OpenView& view,
@@ -215,6 +294,7 @@ OpenLedger::apply(
     ApplyFlags flags,
     beast::Journal j)
 {
+    std::size_t applied = 0;
     for (auto iter = txs.begin(); iter != txs.end(); ++iter)
     {
         try
@@ -224,6 +304,7 @@ OpenLedger::apply(
             auto const txId = tx->getTransactionID();
             if (check.txExists(txId))
                 continue;
+            ++applied;
             auto const result = apply_one(app, view, tx, true, flags, j);
             if (result == Result::retry)
                 retries.insert(tx);
@@ -255,7 +336,7 @@ OpenLedger::apply(
         }
         // A non-retry pass made no changes
         if (!changes && !retry)
-            return;
+            return applied;
         // Stop retriable passes
         if (!changes || (pass >= LEDGER_RETRY_PASSES))
             retry = false;
@@ -264,6 +345,7 @@ OpenLedger::apply(
     // If there are any transactions left, we must have
     // tried them in at least one final pass
     assert(retries.empty() || !retry);
+    return applied;
 }
 
 //------------------------------------------------------------------------------
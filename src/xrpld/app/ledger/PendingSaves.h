@@ -23,10 +23,14 @@
 #include <xrpl/protocol/Protocol.h>
 #include <condition_variable>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 namespace ripple {
 
+class Ledger;
+
 /** Keeps track of which ledgers haven't been fully saved.
 
     During the ledger building process this collection will keep
@@ -40,6 +44,24 @@ private:
     std::map<LedgerIndex, bool> map_;
     std::condition_variable await_;
 
+    // Ledgers waiting to be written by a batch, and whether a job to
+    // write them has been dispatched. Current ledgers and history are
+    // queued apart, so that new ledgers don't wait behind a backfill.
+    struct Queue
+    {
+        std::map<LedgerIndex, std::shared_ptr<Ledger const>> ledgers;
+        bool draining = false;
+    };
+
+    Queue current_;
+    Queue history_;
+
+    Queue&
+    queue(bool isCurrent)
+    {
+        return isCurrent ? current_ : history_;
+    }
+
 public:
     /** Start working on a ledger
 
@@ -127,6 +149,72 @@ public:
         } while (true);
     }
 
+    /** Queue a ledger to be written as part of a batch
+
+        Current ledgers and history ledgers are kept in separate queues,
+        each written by its own job. Ledgers queued while a batch is being
+        written are picked up by the job that is already draining their
+        queue, so at most one such job exists per queue.
+
+        @return 'true' if the caller should dispatch a job to call dequeue
+    */
+    bool
+    enqueue(
+        LedgerIndex seq,
+        std::shared_ptr<Ledger const> const& ledger,
+        bool isCurrent)
+    {
+        std::lock_guard lock(mutex_);
+
+        auto& q = queue(isCurrent);
+        q.ledgers.emplace(seq, ledger);
+
+        if (q.draining)
+            return false;
+
+        q.draining = true;
+        return true;
+    }
+
+    /** Take the next batch of queued ledgers
+
+        @param isCurrent Whether to take from the current ledgers or from
+                         the history ledgers.
+        @param limit The maximum number of ledgers to return.
+        @return Up to `limit` ledgers in ascending sequence order. When
+                nothing is left the batch job should exit, and the next
+                call to enqueue will ask for a new one.
+    */
+    std::vector<std::shared_ptr<Ledger const>>
+    dequeue(bool isCurrent, std::size_t limit)
+    {
+        std::lock_guard lock(mutex_);
+
+        auto& q = queue(isCurrent);
+
+        std::vector<std::shared_ptr<Ledger const>> ret;
+        ret.reserve(std::min(limit, q.ledgers.size()));
+
+        while (!q.ledgers.empty() && ret.size() < limit)
+        {
+            ret.push_back(std::move(q.ledgers.begin()->second));
+            q.ledgers.erase(q.ledgers.begin());
+        }
+
+        if (ret.empty())
+            q.draining = false;
+
+        return ret;
+    }
+
+    /** Return the number of ledgers dispatched or being saved. */
+    std::size_t
+    size() const
+    {
+        std::lock_guard lock(mutex_);
+        return map_.size();
+    }
+
     /** Get a snapshot of the pending saves
 
         Each entry in the returned map corresponds to a ledger
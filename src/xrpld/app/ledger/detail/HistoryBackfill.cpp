@@ -0,0 +1,264 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpld/app/ledger/detail/HistoryBackfill.h>
+#include <xrpl/protocol/Indexes.h>
+#include <xrpl/protocol/jss.h>
+
+#include <algorithm>
+
+namespace ripple {
+
+HistoryBackfill::HistoryBackfill(std::size_t parallel, Stopwatch& clock)
+    : parallel_(std::max<std::size_t>(parallel, 1))
+    , clock_(clock)
+    , saveRate_(clock.now())
+{
+}
+
+void
+HistoryBackfill::add(LedgerIndex seq, uint256 const& hash, LedgerIndex floor)
+{
+    if (seq < floor || seq == 0)
+        return;
+    hashes_.emplace(seq, hash);
+    if ((seq & 0xff) == 0)
+        anchors_.insert(seq);
+}
+
+std::size_t
+HistoryBackfill::learn(ReadView const& ledger, LedgerIndex floor)
+{
+    auto const seq = ledger.seq();
+
+    std::lock_guard lock(mutex_);
+    auto const known = hashes_.size();
+
+    add(seq, ledger.info().hash, floor);
+    if (seq >= floor)
+        acquired_.insert(seq);
+    if (seq > 1)
+        add(seq - 1, ledger.info().parentHash, floor);
+
+    // The ledgers just before this one
+    if (auto const sle = ledger.read(keylet::skip()))
+    {
+        auto const& hashes = sle->getFieldV256(sfHashes);
+        auto const size = hashes.size();
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            if (size - i < seq)
+                add(seq - (size - i), hashes[i], floor);
+        }
+    }
+
+    // Every flag ledger in the horizon below. The lists are split in pages
+    // of 65536 ledgers.
+    auto const low = std::max<LedgerIndex>(
+        std::max<LedgerIndex>(floor, 1), seq > horizon ? seq - horizon : 1);
+    if (seq > low)
+    {
+        for (LedgerIndex page = (seq - 1) >> 16;; --page)
+        {
+            if (auto const sle = ledger.read(keylet::skip(page << 16)))
+            {
+                auto const last = sle->getFieldU32(sfLastLedgerSequence);
+                auto const& hashes = sle->getFieldV256(sfHashes);
+                auto const size = hashes.size();
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    auto const back = 256 * (size - i - 1);
+                    if (back >= last)
+                        continue;
+                    auto const flag = static_cast<LedgerIndex>(last - back);
+                    if (flag >= low && flag < seq)
+                        add(flag, hashes[i], floor);
+                }
+            }
+            if (page <= (low >> 16))
+                break;
+        }
+    }
+
+    return hashes_.size() - known;
+}
+
+std::optional<uint256>
+HistoryBackfill::hashOf(LedgerIndex seq) const
+{
+    std::lock_guard lock(mutex_);
+    auto const it = hashes_.find(seq);
+    if (it == hashes_.end())
+        return std::nullopt;
+    return it->second;
+}
+
+std::vector<HistoryBackfill::Target>
+HistoryBackfill::reap(std::function<bool(uint256 const&)> const& pending)
+{
+    std::vector<Target> done;
+
+    std::lock_guard lock(mutex_);
+    for (auto it = requested_.begin(); it != requested_.end();)
+    {
+        if (pending(it->second))
+        {
+            ++it;
+            continue;
+        }
+        done.push_back(*it);
+        it = requested_.erase(it);
+    }
+    return done;
+}
+
+std::vector<HistoryBackfill::Target>
+HistoryBackfill::next(LedgerIndex missing, LedgerIndex floor)
+{
+    std::vector<Target> result;
+
+    std::lock_guard lock(mutex_);
+    missing_ = missing;
+    floor_ = floor;
+
+    // The gap moved since these were requested
+    std::erase_if(requested_, [missing, floor](auto const& r) {
+        return r.first > missing || r.first < floor;
+    });
+    if (requested_.size() >= parallel_)
+        return result;
+    auto const budget = parallel_ - requested_.size();
+
+    // The ledgers written next, as far down as their hashes are known
+    std::vector<Target> near;
+    LedgerIndex bottom = missing + 1;
+    for (auto seq = missing; seq > 0 && seq >= floor && near.size() < budget;
+         --seq)
+    {
+        auto const it = hashes_.find(seq);
+        if (it == hashes_.end())
+            break;
+        bottom = seq;
+        if (!requested_.count(seq) && !acquired_.count(seq))
+            near.push_back(*it);
+    }
+
+    // The flag ledgers further down, highest first, which would reveal the
+    // hashes of the ledgers before them.
+    std::vector<Target> anchors;
+    std::vector<LedgerIndex> stale;
+    for (auto it = std::make_reverse_iterator(anchors_.lower_bound(bottom));
+         it != anchors_.rend() && anchors.size() < budget;
+         ++it)
+    {
+        auto const seq = *it;
+        if (seq < floor || hashes_.count(seq - 1))
+        {
+            stale.push_back(seq);
+            continue;
+        }
+        if (!requested_.count(seq) && !acquired_.count(seq))
+            anchors.emplace_back(seq, hashes_.at(seq));
+    }
+    for (auto const seq : stale)
+        anchors_.erase(seq);
+
+    // Take from both in turn, so neither starves the other
+    for (std::size_t i = 0;
+         result.size() < budget && (i < near.size() || i < anchors.size());
+         ++i)
+    {
+        if (i < near.size())
+            result.push_back(near[i]);
+        if (i < anchors.size() && result.size() < budget)
+            result.push_back(anchors[i]);
+    }
+
+    for (auto const& target : result)
+        requested_.insert(target);
+    return result;
+}
+
+void
+HistoryBackfill::pass(
+    LedgerIndex missing,
+    LedgerIndex floor,
+    std::function<bool(uint256 const&)> const& pending,
+    std::function<std::shared_ptr<ReadView const>(Target const&)> const&
+        acquire)
+{
+    for (auto const& target : reap(pending))
+    {
+        if (auto const ledger = acquire(target))
+            learn(*ledger, floor);
+    }
+
+    for (auto const& target : next(missing, floor))
+    {
+        if (auto const ledger = acquire(target))
+            learn(*ledger, floor);
+    }
+}
+
+bool
+HistoryBackfill::isAcquired(LedgerIndex seq) const
+{
+    std::lock_guard lock(mutex_);
+    return acquired_.count(seq) != 0;
+}
+
+void
+HistoryBackfill::onSaved(LedgerIndex seq)
+{
+    std::lock_guard lock(mutex_);
+    hashes_.erase(hashes_.lower_bound(seq), hashes_.end());
+    anchors_.erase(anchors_.lower_bound(seq), anchors_.end());
+    acquired_.erase(acquired_.lower_bound(seq), acquired_.end());
+    requested_.erase(seq);
+    ++saved_;
+    saveRate_.add(1, clock_.now());
+}
+
+std::size_t
+HistoryBackfill::inFlight() const
+{
+    std::lock_guard lock(mutex_);
+    return requested_.size();
+}
+
+Json::Value
+HistoryBackfill::getJson()
+{
+    Json::Value ret;
+
+    std::lock_guard lock(mutex_);
+    if (saved_ == 0 && requested_.empty())
+        return ret;
+
+    ret[jss::seq] = missing_;
+    ret[jss::min_ledger] = floor_;
+    ret[jss::acquiring] = static_cast<Json::UInt>(requested_.size());
+    ret[jss::hashes_known] = static_cast<Json::UInt>(hashes_.size());
+    ret[jss::ledgers_saved] = saved_;
+    ret[jss::saved_perminute] =
+        static_cast<Json::UInt>(60 * saveRate_.value(clock_.now()));
+    return ret;
+}
+
+}  // namespace ripple
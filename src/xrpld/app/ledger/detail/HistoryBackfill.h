@@ -0,0 +1,170 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_LEDGER_HISTORYBACKFILL_H_INCLUDED
+#define RIPPLE_APP_LEDGER_HISTORYBACKFILL_H_INCLUDED
+
+#include <xrpld/ledger/ReadView.h>
+#include <xrpl/basics/DecayingSample.h>
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/basics/chrono.h>
+#include <xrpl/json/json_value.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace ripple {
+
+/** Plans the acquisition of missing history, many ledgers at a time.
+
+    Fetching history one ledger at a time waits for each ledger to be
+    acquired before the hash of its parent is known. Instead, the hashes of
+    earlier ledgers are read from the skip lists of every ledger acquired:
+    the 256 ledgers before it, and every flag ledger in the horizon below.
+
+    Acquiring a flag ledger reveals the hashes of the 256 ledgers before
+    it, so flag ledgers serve as anchors: acquiring them alongside the
+    ledgers which are written next keeps many segments of the gap in
+    flight at once, each of them from whichever peers have it.
+
+    Ledgers are written from the top of the gap down, without holes, so
+    an interrupted backfill leaves one contiguous range behind.
+*/
+class HistoryBackfill
+{
+public:
+    using Target = std::pair<LedgerIndex, uint256>;
+
+    /** How far below the next missing ledger flag ledgers are tracked. */
+    static constexpr LedgerIndex horizon = 65536;
+
+    /**
+        @param parallel The most ledgers to acquire at once.
+        @param clock Measures the rate at which ledgers are written.
+    */
+    HistoryBackfill(std::size_t parallel, Stopwatch& clock);
+
+    /** Record the hashes of earlier ledgers found in a ledger.
+
+        The ledger must be part of the validated chain, and fully acquired:
+        it is not chosen for acquisition again until it is written.
+
+        @param ledger The ledger to read the skip lists of.
+        @param floor The earliest ledger wanted.
+        @return The number of hashes which were not known yet.
+    */
+    std::size_t
+    learn(ReadView const& ledger, LedgerIndex floor);
+
+    /** The hash of a ledger, if it has been learned. */
+    std::optional<uint256>
+    hashOf(LedgerIndex seq) const;
+
+    /** Forget the acquisitions which are no longer in progress.
+
+        @param pending Whether the ledger with the given hash is still
+                       being acquired.
+        @return The ledgers which stopped being acquired. They may have
+                been acquired, or the acquisition may have failed.
+    */
+    std::vector<Target>
+    reap(std::function<bool(uint256 const&)> const& pending);
+
+    /** Choose which ledgers to start acquiring.
+
+        The ledgers which are written next and the anchors furthest up the
+        gap are chosen in turn, while fewer than the parallel limit are in
+        flight. The ledgers returned are recorded as in flight.
+
+        @param missing The next ledger to write.
+        @param floor The earliest ledger wanted.
+    */
+    std::vector<Target>
+    next(LedgerIndex missing, LedgerIndex floor);
+
+    /** Learn from the acquisitions which finished, and start new ones.
+
+        Ledgers acquired for history are not kept in the ledger history,
+        so those which finished are taken back from the acquisition.
+
+        @param missing The next ledger to write.
+        @param floor The earliest ledger wanted.
+        @param pending Whether the ledger with the given hash is still
+                       being acquired.
+        @param acquire Starts acquiring a ledger, and returns it if it has
+                       been acquired.
+    */
+    void
+    pass(
+        LedgerIndex missing,
+        LedgerIndex floor,
+        std::function<bool(uint256 const&)> const& pending,
+        std::function<std::shared_ptr<ReadView const>(Target const&)> const&
+            acquire);
+
+    /** Whether a ledger not written yet has been acquired. */
+    bool
+    isAcquired(LedgerIndex seq) const;
+
+    /** A ledger was written.
+
+        Hashes at and above the ledger are forgotten.
+    */
+    void
+    onSaved(LedgerIndex seq);
+
+    /** The number of ledgers being acquired. */
+    std::size_t
+    inFlight() const;
+
+    /** Progress, for server_info. Null if nothing was ever backfilled. */
+    Json::Value
+    getJson();
+
+private:
+    void
+    add(LedgerIndex seq, uint256 const& hash, LedgerIndex floor);
+
+    std::size_t const parallel_;
+    Stopwatch& clock_;
+
+    std::mutex mutable mutex_;
+    // Learned hashes of ledgers not written yet
+    std::map<LedgerIndex, uint256> hashes_;
+    // Flag ledgers whose predecessors may not be known
+    std::set<LedgerIndex> anchors_;
+    // Ledgers being acquired
+    std::map<LedgerIndex, uint256> requested_;
+    // Ledgers acquired and not written yet
+    std::set<LedgerIndex> acquired_;
+    LedgerIndex missing_ = 0;
+    LedgerIndex floor_ = 0;
+    std::uint32_t saved_ = 0;
+    DecayWindow<30, Stopwatch> saveRate_;
+};
+
+}  // namespace ripple
+
+#endif
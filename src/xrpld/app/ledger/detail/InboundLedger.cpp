@@ -60,14 +60,6 @@ enum {
     // Number of nodes to find initially
     ,
     missingNodesFind = 256
-
-    // Number of nodes to request for a reply
-    ,
-    reqNodesReply = 128
-
-    // Number of nodes to request blindly
-    ,
-    reqNodes = 12
 };
 
 // millisecond for each ledger timeout
@@ -94,6 +86,7 @@ InboundLedger::InboundLedger(
     , mByHash(true)
     , mSeq(seq)
     , mReason(reason)
+    , mFetchWindows(clock, ledgerAcquireTimeout)
     , mReceiveDispatched(false)
     , mPeerSet(std::move(peerSet))
 {
@@ -363,7 +356,7 @@ InboundLedger::tryDB(NodeStore::Database& srcDB)
 void
 InboundLedger::onTimer(bool wasProgress, ScopedLockType&)
 {
-    mRecentNodes.clear();
+    mFetchWindows.expire();
 
     if (isDone())
     {
@@ -398,6 +391,9 @@ InboundLedger::onTimer(bool wasProgress, ScopedLockType&)
         JLOG(journal_.debug())
             << "No progress(" << pc << ") for ledger " << hash_;
 
+        // Ask again for everything outstanding, of any peer
+        mFetchWindows.reset();
+
         // addPeers triggers if the reason is not HISTORY
         // So if the reason IS HISTORY, need to trigger after we add
         // otherwise, we need to trigger before we add
@@ -633,11 +629,12 @@ InboundLedger::trigger(std::shared_ptr<Peer> const& peer, TriggerReason reason)
         {
             AccountStateSF filter(
                 mLedger->stateMap().family().db(), app_.getLedgerMaster());
+            auto const peers = fetchPeers(peer, reason);
+            auto const wanted = fetchWanted(peers);
 
             // Release the lock while we process the large state map
             sl.unlock();
-            auto nodes =
-                mLedger->stateMap().getMissingNodes(missingNodesFind, &filter);
+            auto nodes = mLedger->stateMap().getMissingNodes(wanted, &filter);
             sl.lock();
 
             // Make sure nothing happened while we released the lock
@@ -657,27 +654,11 @@ InboundLedger::trigger(std::shared_ptr<Peer> const& peer, TriggerReason reason)
                 }
                 else
                 {
-                    filterNodes(nodes, reason);
-
-                    if (!nodes.empty())
-                    {
-                        tmGL.set_itype(protocol::liAS_NODE);
-                        for (auto const& id : nodes)
-                        {
-                            *(tmGL.add_nodeids()) = id.first.getRawString();
-                        }
-
-                        JLOG(journal_.trace())
-                            << "Sending AS node request (" << nodes.size()
-                            << ") to "
-                            << (peer ? "selected peer" : "all peers");
-                        mPeerSet->sendRequest(tmGL, peer);
+                    tmGL.set_itype(protocol::liAS_NODE);
+                    if (requestNodes(tmGL, nodes, peers, reason))
                         return;
-                    }
-                    else
-                    {
-                        JLOG(journal_.trace()) << "All AS nodes filtered";
-                    }
+
+                    JLOG(journal_.trace()) << "No AS nodes left to request";
                 }
             }
         }
@@ -705,9 +686,10 @@ InboundLedger::trigger(std::shared_ptr<Peer> const& peer, TriggerReason reason)
         {
             TransactionStateSF filter(
                 mLedger->txMap().family().db(), app_.getLedgerMaster());
+            auto const peers = fetchPeers(peer, reason);
 
             auto nodes =
-                mLedger->txMap().getMissingNodes(missingNodesFind, &filter);
+                mLedger->txMap().getMissingNodes(fetchWanted(peers), &filter);
 
             if (nodes.empty())
             {
@@ -723,25 +705,11 @@ InboundLedger::trigger(std::shared_ptr<Peer> const& peer, TriggerReason reason)
             }
             else
             {
-                filterNodes(nodes, reason);
-
-                if (!nodes.empty())
-                {
-                    tmGL.set_itype(protocol::liTX_NODE);
-                    for (auto const& n : nodes)
-                    {
-                        *(tmGL.add_nodeids()) = n.first.getRawString();
-                    }
-                    JLOG(journal_.trace())
-                        << "Sending TX node request (" << nodes.size()
-                        << ") to " << (peer ? "selected peer" : "all peers");
-                    mPeerSet->sendRequest(tmGL, peer);
+                tmGL.set_itype(protocol::liTX_NODE);
+                if (requestNodes(tmGL, nodes, peers, reason))
                     return;
-                }
-                else
-                {
-                    JLOG(journal_.trace()) << "All TX nodes filtered";
-                }
+
+                JLOG(journal_.trace()) << "No TX nodes left to request";
             }
         }
     }
@@ -756,46 +724,96 @@ InboundLedger::trigger(std::shared_ptr<Peer> const& peer, TriggerReason reason)
     }
 }
 
-void
-InboundLedger::filterNodes(
-    std::vector<std::pair<SHAMapNodeID, uint256>>& nodes,
-    TriggerReason reason)
-{
-    // Sort nodes so that the ones we haven't recently
-    // requested come before the ones we have.
-    auto dup = std::stable_partition(
-        nodes.begin(), nodes.end(), [this](auto const& item) {
-            return mRecentNodes.count(item.second) == 0;
-        });
+/** The peers to ask for nodes
 
-    // If everything is a duplicate we don't want to send
-    // any query at all except on a timeout where we need
-    // to query everyone:
-    if (dup == nodes.begin())
+    A peer which was just added is asked on its own. Otherwise every peer in
+    the set may be asked, so that none of them sits idle while another one
+    answers.
+*/
+std::vector<std::shared_ptr<Peer>>
+InboundLedger::fetchPeers(
+    std::shared_ptr<Peer> const& peer,
+    TriggerReason reason) const
+{
+    std::vector<std::shared_ptr<Peer>> peers;
+    if (peer)
     {
-        JLOG(journal_.trace()) << "filterNodes: all duplicates";
-
-        if (reason != TriggerReason::timeout)
-        {
-            nodes.clear();
-            return;
-        }
+        peers.push_back(peer);
+        if (reason == TriggerReason::added)
+            return peers;
     }
-    else
-    {
-        JLOG(journal_.trace()) << "filterNodes: pruning duplicates";
 
-        nodes.erase(dup, nodes.end());
+    for (auto const id : mPeerSet->getPeerIds())
+    {
+        if (peer && id == peer->id())
+            continue;
+        if (auto p = app_.overlay().findPeerByShortID(id))
+            peers.push_back(std::move(p));
     }
+    return peers;
+}
 
-    std::size_t const limit =
-        (reason == TriggerReason::reply) ? reqNodesReply : reqNodes;
+/** How many missing nodes to look for
 
-    if (nodes.size() > limit)
-        nodes.resize(limit);
+    Enough to fill the windows of all the peers, beyond the nodes they are
+    already asked for.
+*/
+int
+InboundLedger::fetchWanted(
+    std::vector<std::shared_ptr<Peer>> const& peers) const
+{
+    std::vector<Peer::id_t> ids;
+    ids.reserve(peers.size());
+    for (auto const& p : peers)
+        ids.push_back(p->id());
+
+    return std::max<std::size_t>(
+        missingNodesFind,
+        mFetchWindows.outstanding() + mFetchWindows.capacity(ids));
+}
+
+/** Split missing nodes among peers and send the requests
+
+    Nodes already asked of a peer are not asked of another until that
+    request times out. Returns true if anything was sent.
+*/
+bool
+InboundLedger::requestNodes(
+    protocol::TMGetLedger& tmGL,
+    std::vector<std::pair<SHAMapNodeID, uint256>> const& nodes,
+    std::vector<std::shared_ptr<Peer>> const& peers,
+    TriggerReason reason)
+{
+    std::vector<Peer::id_t> ids;
+    ids.reserve(peers.size());
+    for (auto const& p : peers)
+        ids.push_back(p->id());
 
-    for (auto const& n : nodes)
-        mRecentNodes.insert(n.second);
+    bool sent = false;
+    for (auto const& [id, assigned] : mFetchWindows.assign(nodes, ids))
+    {
+        auto const& p = *std::find_if(
+            peers.begin(), peers.end(), [id = id](auto const& p) {
+                return p->id() == id;
+            });
+
+        tmGL.clear_nodeids();
+        for (auto const& n : assigned)
+            *(tmGL.add_nodeids()) = n.first.getRawString();
+
+        // Each peer answering a reply gets the depth its latency calls for
+        if (reason == TriggerReason::reply)
+            tmGL.set_querydepth(p->isHighLatency() ? 2 : 1);
+
+        JLOG(journal_.trace())
+            << "Sending " << (tmGL.itype() == protocol::liTX_NODE ? "TX" : "AS")
+            << " node request (" << assigned.size() << ") to " << id
+            << " window " << mFetchWindows.window(id);
+        mPeerSet->sendRequest(tmGL, p);
+        sent = true;
+    }
+
+    return sent;
 }
 
 /** Take ledger header data
@@ -1138,6 +1156,16 @@ InboundLedger::processData(
             }
         }
 
+        // A late reply must not be timed against a newer request
+        auto const first = deserializeSHAMapNodeID(packet.nodes(0).nodeid());
+        if (!first ||
+            !mFetchWindows.onReply(peer->id(), *first, packet.nodes().size()))
+        {
+            JLOG(journal_.debug())
+                << peer->id() << ": reply does not answer the outstanding "
+                << "request";
+        }
+
         SHAMapAddNode san;
         receiveNode(packet, san);
 
@@ -143,12 +143,13 @@ public:
 // Don't catch up more than 100 ledgers (cannot exceed 256)
 static constexpr int MAX_LEDGER_GAP{100};
 
+// Don't catch up more ledgers than one replay can build, when replaying
+static constexpr int MAX_REPLAY_GAP{
+    LedgerReplayParameters::MAX_REPLAY_LEDGERS - 1};
+
 // Don't acquire history if ledger is too old
 static constexpr std::chrono::minutes MAX_LEDGER_AGE_ACQUIRE{1};
 
-// Don't acquire history if write load is too high
-static constexpr int MAX_WRITE_LOAD_ACQUIRE{8192};
-
 // Helper function for LedgerMaster::doAdvance()
 // Return true if candidateLedger should be fetched from the network.
 static bool
@@ -197,6 +198,10 @@ LedgerMaster::LedgerMaster(
           std::chrono::seconds{45},
           stopwatch,
           app_.journal("TaggedCache"))
+    , backfill_(
+          app_.config().BACKFILL_PARALLEL ? app_.config().BACKFILL_PARALLEL
+                                          : 4 * ledger_fetch_size_,
+          stopwatch)
     , m_stats(std::bind(&LedgerMaster::collect_metrics, this), collector)
 {
 }
@@ -1311,10 +1316,17 @@ LedgerMaster::findNewLedgersToPublish(
         return {mValidLedger.get()};
     }
 
-    if (mValidLedgerSeq > (mPubLedgerSeq + MAX_LEDGER_GAP))
+    // Replaying deltas is cheap enough to catch up across longer gaps than
+    // acquiring every ledger in full.
+    auto const maxGap =
+        app_.config().LEDGER_REPLAY ? MAX_REPLAY_GAP : MAX_LEDGER_GAP;
+    if (mValidLedgerSeq > (mPubLedgerSeq + maxGap))
     {
         JLOG(m_journal.warn()) << "Gap in validated ledger stream "
                                << mPubLedgerSeq << " - " << mValidLedgerSeq - 1;
+        if (app_.config().LEDGER_REPLAY)
+            app_.getLedgerReplayer().onGapSkipped(
+                mValidLedgerSeq - mPubLedgerSeq - 1);
 
         auto valLedger = mValidLedger.get();
         ret.push_back(valLedger);
@@ -1339,32 +1351,54 @@ LedgerMaster::findNewLedgersToPublish(
     ScopedUnlock sul{sl};
     try
     {
-        for (std::uint32_t seq = pubSeq; seq <= valSeq; ++seq)
+        // A replayed gap can be longer than the skip list of the validated
+        // ledger. Walk back through the ledgers already here, until the skip
+        // list of the last one reaches the next ledger to publish.
+        std::vector<std::shared_ptr<Ledger const>> chain{valLedger};
+        while (chain.back()->seq() > pubSeq + 256)
+        {
+            auto parent =
+                mLedgerHistory.getLedgerByHash(chain.back()->info().parentHash);
+            if (!parent)
+                break;
+            chain.push_back(std::move(parent));
+        }
+        auto const chainSeq = chain.back()->seq();
+        bool const reachable = chainSeq <= pubSeq + 256;
+
+        for (std::uint32_t seq = pubSeq; reachable && seq <= valSeq; ++seq)
         {
             JLOG(m_journal.trace())
                 << "Trying to fetch/publish valid ledger " << seq;
 
             std::shared_ptr<Ledger const> ledger;
-            // This can throw
-            auto hash = hashOfSeq(*valLedger, seq, m_journal);
-            // VFALCO TODO Restructure this code so that zero is not
-            // used.
-            if (!hash)
-                hash = beast::zero;  // kludge
-            if (seq == valSeq)
-            {
-                // We need to publish the ledger we just fully validated
-                ledger = valLedger;
-            }
-            else if (hash->isZero())
+            std::optional<uint256> hash;
+            if (seq >= chainSeq)
             {
-                JLOG(m_journal.fatal()) << "Ledger: " << valSeq
-                                        << " does not have hash for " << seq;
-                assert(false);
+                // We need to publish the ledger we just fully validated, and
+                // the ledgers found walking back from it
+                ledger = chain[valSeq - seq];
+                hash = ledger->info().hash;
             }
             else
             {
-                ledger = mLedgerHistory.getLedgerByHash(*hash);
+                // This can throw
+                hash = hashOfSeq(*chain.back(), seq, m_journal);
+                // VFALCO TODO Restructure this code so that zero is not
+                // used.
+                if (!hash)
+                    hash = beast::zero;  // kludge
+                if (hash->isZero())
+                {
+                    JLOG(m_journal.fatal())
+                        << "Ledger: " << chainSeq << " does not have hash for "
+                        << seq;
+                    assert(false);
+                }
+                else
+                {
+                    ledger = mLedgerHistory.getLedgerByHash(*hash);
+                }
             }
 
             if (!app_.config().LEDGER_REPLAY)
@@ -1422,7 +1456,7 @@ LedgerMaster::findNewLedgersToPublish(
                     << startLedger->info().hash
                     << " to seq=" << finishLedger->info().seq << ", "
                     << finishLedger->info().hash;
-                app_.getLedgerReplayer().replay(
+                app_.getLedgerReplayer().catchUp(
                     InboundLedger::Reason::GENERIC,
                     finishLedger->info().hash,
                     numberLedgers);
@@ -1883,7 +1917,18 @@ LedgerMaster::fetchForHistory(
     std::unique_lock<std::recursive_mutex>& sl)
 {
     ScopedUnlock sul{sl};
-    if (auto hash = getLedgerHashForHistory(missing, reason))
+    auto const floor = backfillFloor(missing);
+    auto hash = backfill_.hashOf(missing);
+    if (!hash)
+    {
+        // Learn the hashes below the gap from the ledger above it
+        if (auto const above = getLedgerBySeq(missing + 1))
+            backfill_.learn(*above, floor);
+        hash = backfill_.hashOf(missing);
+    }
+    if (!hash)
+        hash = getLedgerHashForHistory(missing, reason);
+    if (hash)
     {
         assert(hash->isNonZero());
         auto ledger = getLedgerByHash(*hash);
@@ -1913,8 +1958,33 @@ LedgerMaster::fetchForHistory(
         {
             auto seq = ledger->info().seq;
             assert(seq == missing);
-            JLOG(m_journal.trace()) << "fetchForHistory acquired " << seq;
-            setFullLedger(ledger, false, false);
+
+            // Write this ledger, and those below it which were acquired
+            // already, from the top down.
+            for (;;)
+            {
+                JLOG(m_journal.trace()) << "fetchForHistory acquired " << seq;
+                setFullLedger(ledger, false, false);
+                backfill_.learn(*ledger, floor);
+                backfill_.onSaved(seq);
+
+                if (seq <= floor || haveLedger(seq - 1))
+                    break;
+                auto const parent = backfill_.hashOf(seq - 1);
+                if (!parent)
+                    break;
+                auto next = getLedgerByHash(*parent);
+                // Ledgers acquired for history are not kept in the ledger
+                // history
+                if (!next && backfill_.isAcquired(seq - 1))
+                    next = app_.getInboundLedgers().acquire(
+                        *parent, seq - 1, reason);
+                if (!next)
+                    break;
+                ledger = std::move(next);
+                --seq;
+            }
+
             int fillInProgress;
             {
                 std::lock_guard lock(m_mutex);
@@ -1936,34 +2006,12 @@ LedgerMaster::fetchForHistory(
                     });
             }
             progress = true;
+
+            if (seq <= floor)
+                return;
+            missing = seq - 1;
         }
-        else
-        {
-            std::uint32_t fetchSz;
-            // Do not fetch ledger sequences lower
-            // than the earliest ledger sequence
-            fetchSz = app_.getNodeStore().earliestLedgerSeq();
-            fetchSz = missing >= fetchSz
-                ? std::min(ledger_fetch_size_, (missing - fetchSz) + 1)
-                : 0;
-            try
-            {
-                for (std::uint32_t i = 0; i < fetchSz; ++i)
-                {
-                    std::uint32_t seq = missing - i;
-                    if (auto h = getLedgerHashForHistory(seq, reason))
-                    {
-                        assert(h->isNonZero());
-                        app_.getInboundLedgers().acquire(*h, seq, reason);
-                    }
-                }
-            }
-            catch (std::exception const& ex)
-            {
-                JLOG(m_journal.warn())
-                    << "Threw while prefetching: " << ex.what();
-            }
-        }
+        backfill(missing, floor, reason);
     }
     else
     {
@@ -1982,6 +2030,56 @@ LedgerMaster::fetchForHistory(
     }
 }
 
+LedgerIndex
+LedgerMaster::backfillFloor(LedgerIndex missing)
+{
+    // The bounds shouldAcquire applies
+    LedgerIndex floor = mValidLedgerSeq > ledger_history_
+        ? mValidLedgerSeq - ledger_history_
+        : 0;
+    if (auto const minimum = app_.getSHAMapStore().minimumOnline())
+        floor = std::min(floor, *minimum);
+    floor = std::max(floor, app_.getNodeStore().earliestLedgerSeq());
+    floor = std::min(floor, missing);
+
+    // Stop above the ledgers we have
+    std::lock_guard sl(mCompleteLock);
+    RangeSet<std::uint32_t> have{range(floor, missing)};
+    have &= mCompleteLedgers;
+    if (!have.empty())
+        floor = boost::icl::last(have) + 1;
+    return floor;
+}
+
+void
+LedgerMaster::backfill(
+    LedgerIndex missing,
+    LedgerIndex floor,
+    InboundLedger::Reason reason)
+{
+    auto& inbound = app_.getInboundLedgers();
+    try
+    {
+        backfill_.pass(
+            missing,
+            floor,
+            [&inbound](uint256 const& hash) {
+                auto const il = inbound.find(hash);
+                return il && !il->isComplete() && !il->isFailed();
+            },
+            [&inbound, reason](HistoryBackfill::Target const& target)
+                -> std::shared_ptr<ReadView const> {
+                if (inbound.isFailure(target.second))
+                    return {};
+                return inbound.acquire(target.second, target.first, reason);
+            });
+    }
+    catch (std::exception const& ex)
+    {
+        JLOG(m_journal.warn()) << "Threw while prefetching: " << ex.what();
+    }
+}
+
 // Try to publish ledgers, acquire missing ledgers
 void
 LedgerMaster::doAdvance(std::unique_lock<std::recursive_mutex>& sl)
@@ -1998,7 +2096,8 @@ LedgerMaster::doAdvance(std::unique_lock<std::recursive_mutex>& sl)
                 (app_.getJobQueue().getJobCount(jtPUBOLDLEDGER) < 10) &&
                 (mValidLedgerSeq == mPubLedgerSeq) &&
                 (getValidatedLedgerAge() < MAX_LEDGER_AGE_ACQUIRE) &&
-                (app_.getNodeStore().getWriteLoad() < MAX_WRITE_LOAD_ACQUIRE))
+                (app_.getNodeStore().getWriteLoad() <
+                 app_.config().BACKFILL_MAX_WRITE_LOAD))
             {
                 // We are in sync, so can acquire
                 InboundLedger::Reason reason = InboundLedger::Reason::HISTORY;
@@ -2300,6 +2399,12 @@ LedgerMaster::getFetchPackCacheSize() const
     return fetch_packs_.getCacheSize();
 }
 
+Json::Value
+LedgerMaster::getBackfillJson()
+{
+    return backfill_.getJson();
+}
+
 // Returns the minimum ledger sequence in SQL database, if any.
 std::optional<LedgerIndex>
 LedgerMaster::minSqlSeq()
@@ -61,7 +61,7 @@ LedgerReplayTask::TaskParameter::canMergeInto(
     if (reason_ == existingTask.reason_)
     {
         if (finishHash_ == existingTask.finishHash_ &&
-            totalLedgers_ <= existingTask.totalLedgers_)
+            coverage() <= existingTask.coverage())
         {
             return true;
         }
@@ -72,8 +72,8 @@ LedgerReplayTask::TaskParameter::canMergeInto(
             if (auto i = std::find(exList.begin(), exList.end(), finishHash_);
                 i != exList.end())
             {
-                return existingTask.totalLedgers_ >=
-                    totalLedgers_ + (exList.end() - i) - 1;
+                return existingTask.coverage() >=
+                    coverage() + (exList.end() - i) - 1;
             }
         }
     }
@@ -152,6 +152,29 @@ LedgerReplayTask::trigger(ScopedLockType& sl)
     if (!parent_)
     {
         parent_ = app_.getLedgerMaster().getLedgerByHash(parameter_.startHash_);
+        if (!parent_ && waitForStart_)
+        {
+            // The task below builds the start ledger. Wait for it, unless it
+            // failed.
+            if (auto const below = below_.lock())
+            {
+                if (auto l = below->finishLedger();
+                    l && l->info().hash == parameter_.startHash_)
+                    parent_ = std::move(l);
+                else if (!below->finished())
+                {
+                    progress_ = true;
+                    return;
+                }
+            }
+            if (!parent_)
+            {
+                JLOG(journal_.debug())
+                    << "Chained task failed, acquiring start ledger "
+                    << parameter_.startHash_ << " for task " << hash_;
+            }
+            waitForStart_ = false;
+        }
         if (!parent_)
         {
             parent_ = inboundLedgers_.acquire(
@@ -175,9 +198,40 @@ LedgerReplayTask::deltaReady(uint256 const& deltaHash)
 {
     JLOG(journal_.trace()) << "Delta " << deltaHash << " ready for task "
                            << hash_;
+    // Deltas are verified in parallel, but the ledgers are built in order.
+    // One job builds all the ledgers whose deltas are ready by then.
+    if (buildQueued_.exchange(true))
+        return;
+    if (!app_.getJobQueue().addJob(
+            jtREPLAY_TASK,
+            "LedgerReplayBuild",
+            [wptr = std::weak_ptr<LedgerReplayTask>(shared_from_this())]() {
+                if (auto sptr = wptr.lock(); sptr)
+                {
+                    sptr->buildQueued_ = false;
+                    ScopedLockType sl(sptr->mtx_);
+                    if (!sptr->isDone())
+                        sptr->tryAdvance(sl);
+                }
+            }))
+    {
+        buildQueued_ = false;
+    }
+}
+
+void
+LedgerReplayTask::startReady(std::shared_ptr<Ledger const> const& ledger)
+{
     ScopedLockType sl(mtx_);
-    if (!isDone())
-        tryAdvance(sl);
+    if (isDone() || parent_ || !parameter_.full_ ||
+        ledger->info().hash != parameter_.startHash_)
+        return;
+
+    JLOG(journal_.trace()) << "Got start ledger " << parameter_.startHash_
+                           << " from the chained task, for task " << hash_;
+    parent_ = ledger;
+    waitForStart_ = false;
+    tryAdvance(sl);
 }
 
 void
@@ -201,8 +255,12 @@ LedgerReplayTask::tryAdvance(ScopedLockType& sl)
         {
             auto& delta = deltas_[deltaToBuild_];
             assert(parent_->seq() + 1 == delta->ledgerSeq_);
+            auto const start = std::chrono::steady_clock::now();
             if (auto l = delta->tryBuild(parent_); l)
             {
+                replayer_.onLedgerBuilt(
+                    std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() - start));
                 JLOG(journal_.debug())
                     << "Task " << hash_ << " got ledger " << l->info().hash
                     << " deltaIndex=" << deltaToBuild_
@@ -215,6 +273,18 @@ LedgerReplayTask::tryAdvance(ScopedLockType& sl)
 
         complete_ = true;
         JLOG(journal_.info()) << "Completed " << hash_;
+
+        for (auto const& above : above_)
+        {
+            app_.getJobQueue().addJob(
+                jtREPLAY_TASK,
+                "LedgerReplayChain",
+                [wptr = above, ledger = parent_]() {
+                    if (auto sptr = wptr.lock(); sptr)
+                        sptr->startReady(ledger);
+                });
+        }
+        above_.clear();
     }
     catch (std::runtime_error const&)
     {
@@ -241,7 +311,23 @@ LedgerReplayTask::updateSkipList(
     }
 
     replayer_.createDeltas(shared_from_this());
+
+    // The ledgers before the start are replayed by a chain of tasks below,
+    // and the start ledger is taken from the task right below.
+    std::shared_ptr<LedgerReplayTask> below;
+    if (parameter_.ledgersBelow_ > 1)
+    {
+        below = replayer_.replay(
+            parameter_.reason_,
+            parameter_.startHash_,
+            parameter_.ledgersBelow_);
+        if (below)
+            below->setAbove(shared_from_this());
+    }
+
     ScopedLockType sl(mtx_);
+    below_ = below;
+    waitForStart_ = below != nullptr;
     if (!isDone())
         trigger(sl);
 }
@@ -303,4 +389,21 @@ LedgerReplayTask::finished() const
     return isDone();
 }
 
+std::shared_ptr<Ledger const>
+LedgerReplayTask::finishLedger() const
+{
+    ScopedLockType sl(mtx_);
+    if (!complete_)
+        return {};
+    return parent_;
+}
+
+void
+LedgerReplayTask::setAbove(std::weak_ptr<LedgerReplayTask> const& above)
+{
+    ScopedLockType sl(mtx_);
+    if (!isDone())
+        above_.push_back(above);
+}
+
 }  // namespace ripple
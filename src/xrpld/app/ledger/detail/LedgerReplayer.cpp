@@ -41,7 +41,7 @@ LedgerReplayer::~LedgerReplayer()
     tasks_.clear();
 }
 
-void
+std::shared_ptr<LedgerReplayTask>
 LedgerReplayer::replay(
     InboundLedger::Reason r,
     uint256 const& finishLedgerHash,
@@ -49,10 +49,17 @@ LedgerReplayer::replay(
 {
     assert(
         finishLedgerHash.isNonZero() && totalNumLedgers > 0 &&
-        totalNumLedgers <= LedgerReplayParameters::MAX_TASK_SIZE);
+        totalNumLedgers <= LedgerReplayParameters::MAX_REPLAY_LEDGERS);
 
+    // A longer range is replayed by this task and a chain of tasks below it,
+    // created when the skip list of this task's finish ledger is known.
     LedgerReplayTask::TaskParameter parameter(
-        r, finishLedgerHash, totalNumLedgers);
+        r,
+        finishLedgerHash,
+        std::min(totalNumLedgers, LedgerReplayParameters::MAX_TASK_SIZE));
+    if (totalNumLedgers > LedgerReplayParameters::MAX_TASK_SIZE)
+        parameter.ledgersBelow_ =
+            totalNumLedgers - LedgerReplayParameters::MAX_TASK_SIZE + 1;
 
     std::shared_ptr<LedgerReplayTask> task;
     std::shared_ptr<SkipListAcquire> skipList;
@@ -60,12 +67,12 @@ LedgerReplayer::replay(
     {
         std::lock_guard<std::mutex> lock(mtx_);
         if (app_.isStopping())
-            return;
+            return {};
         if (tasks_.size() >= LedgerReplayParameters::MAX_TASKS)
         {
             JLOG(j_.info()) << "Too many replay tasks, dropping new task "
                             << parameter.finishHash_;
-            return;
+            return {};
         }
 
         for (auto const& t : tasks_)
@@ -75,7 +82,9 @@ LedgerReplayer::replay(
                 JLOG(j_.info()) << "Task " << parameter.finishHash_ << " with "
                                 << totalNumLedgers
                                 << " ledgers merged into an existing task.";
-                return;
+                if (t->getTaskParameter().finishHash_ == parameter.finishHash_)
+                    return t;
+                return {};
             }
         }
         JLOG(j_.info()) << "Replay " << totalNumLedgers
@@ -106,6 +115,49 @@ LedgerReplayer::replay(
         skipList->init(1);
     // task init after skipList init, could save a timeout
     task->init();
+    return task;
+}
+
+void
+LedgerReplayer::catchUp(
+    InboundLedger::Reason r,
+    uint256 const& finishLedgerHash,
+    std::uint32_t totalNumLedgers)
+{
+    {
+        // The same gap is asked for until it is replayed
+        std::lock_guard lock(statsMtx_);
+        if (lastCatchUp_ != finishLedgerHash)
+        {
+            lastCatchUp_ = finishLedgerHash;
+            ++stats_.replays;
+            stats_.replayLedgers += totalNumLedgers - 1;
+        }
+    }
+    replay(r, finishLedgerHash, totalNumLedgers);
+}
+
+void
+LedgerReplayer::onGapSkipped(std::uint32_t numLedgers)
+{
+    std::lock_guard lock(statsMtx_);
+    ++stats_.skips;
+    stats_.skipLedgers += numLedgers;
+}
+
+void
+LedgerReplayer::onLedgerBuilt(std::chrono::microseconds elapsed)
+{
+    std::lock_guard lock(statsMtx_);
+    ++stats_.built;
+    stats_.buildTime += elapsed;
+}
+
+LedgerReplayer::CatchUpStats
+LedgerReplayer::getCatchUpStats() const
+{
+    std::lock_guard lock(statsMtx_);
+    return stats_;
 }
 
 void
@@ -215,6 +267,14 @@ LedgerReplayer::gotReplayDelta(
         delta->processData(info, std::move(txns));
 }
 
+bool
+LedgerReplayer::wantsReplayDelta(uint256 const& hash) const
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto i = deltas_.find(hash);
+    return i != deltas_.end() && !i->second.expired();
+}
+
 void
 LedgerReplayer::sweep()
 {
@@ -79,27 +79,45 @@ OpenLedger::accept(
     std::string const& suffix,
     modify_type const& f)
 {
-    JLOG(j_.trace()) << "accept ledger " << ledger->seq() << " " << suffix;
-    auto next = create(rules, ledger);
+    accept(
+        app,
+        prepare(app, rules, ledger, retriesFirst, retries, flags),
+        locals,
+        retries,
+        flags,
+        suffix,
+        f);
+}
+
+OpenLedger::Prepared
+OpenLedger::prepare(
+    Application& app,
+    Rules const& rules,
+    std::shared_ptr<Ledger const> const& ledger,
+    bool retriesFirst,
+    OrderedTxs& retries,
+    ApplyFlags flags)
+{
+    using namespace std::chrono;
+    auto const start = steady_clock::now();
+
+    Prepared prepared{ledger, create(rules, ledger), current()};
     if (retriesFirst)
     {
         // Handle disputed tx, outside lock
         using empty = std::vector<std::shared_ptr<STTx const>>;
-        apply(app, *next, *ledger, empty{}, retries, flags, j_);
+        apply(app, *prepared.view, *ledger, empty{}, retries, flags, j_);
     }
-    // Block calls to modify, otherwise
-    // new tx going into the open ledger
-    // would get lost.
-    std::lock_guard lock1(modify_mutex_);
-    // Apply tx from the current open view
-    if (!current_->txs.empty())
+    // Apply tx from the snapshot of the open view, outside lock
+    std::size_t replayed = 0;
+    if (!prepared.snapshot->txs.empty())
     {
-        apply(
+        replayed = apply(
             app,
-            *next,
+            *prepared.view,
             *ledger,
             boost::adaptors::transform(
-                current_->txs,
+                prepared.snapshot->txs,
                 [](std::pair<
                     std::shared_ptr<STTx const>,
                     std::shared_ptr<STObject const>> const& p) {
@@ -109,6 +127,58 @@ OpenLedger::accept(
             flags,
             j_);
     }
+
+    auto const elapsed =
+        duration_cast<microseconds>(steady_clock::now() - start);
+    JLOG(j_.debug()) << "prepare ledger " << ledger->seq() << ": replayed "
+                     << replayed << " in " << elapsed.count() << "us";
+    std::lock_guard lock(stats_mutex_);
+    stats_.replayed += replayed;
+    stats_.replayTime += elapsed;
+    return prepared;
+}
+
+void
+OpenLedger::accept(
+    Application& app,
+    Prepared prepared,
+    OrderedTxs const& locals,
+    OrderedTxs& retries,
+    ApplyFlags flags,
+    std::string const& suffix,
+    modify_type const& f)
+{
+    using namespace std::chrono;
+    auto const& ledger = prepared.ledger;
+    auto next = std::move(prepared.view);
+    JLOG(j_.trace()) << "accept ledger " << ledger->seq() << " " << suffix;
+    // Block calls to modify, otherwise
+    // new tx going into the open ledger
+    // would get lost.
+    std::lock_guard lock1(modify_mutex_);
+    auto const start = steady_clock::now();
+    // Apply tx which reached the open view after the snapshot
+    std::size_t replayed = 0;
+    if (current_ != prepared.snapshot)
+    {
+        std::vector<std::shared_ptr<STTx const>> late;
+        for (auto const& item : current_->txs)
+        {
+            if (!prepared.snapshot->txExists(item.first->getTransactionID()))
+                late.push_back(item.first);
+        }
+        if (!late.empty())
+            replayed = apply(app, *next, *ledger, late, retries, flags, j_);
+    }
+    auto const elapsed =
+        duration_cast<microseconds>(steady_clock::now() - start);
+    JLOG(j_.debug()) << "accept ledger " << ledger->seq() << ": replayed "
+                     << replayed << " in " << elapsed.count() << "us";
+    {
+        std::lock_guard lock(stats_mutex_);
+        stats_.replayedLocked += replayed;
+        stats_.replayLockedTime += elapsed;
+    }
     // Call the modifier
     if (f)
         f(*next, j_);
@@ -141,6 +211,13 @@ OpenLedger::accept(
     current_ = std::move(next);
 }
 
+OpenLedger::ReplayStats
+OpenLedger::getReplayStats() const
+{
+    std::lock_guard lock(stats_mutex_);
+    return stats_;
+}
+
 //------------------------------------------------------------------------------
 
 std::shared_ptr<OpenView>
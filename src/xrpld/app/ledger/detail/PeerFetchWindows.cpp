@@ -0,0 +1,266 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpld/app/ledger/detail/PeerFetchWindows.h>
+
+#include <algorithm>
+#include <array>
+
+namespace ripple {
+
+using namespace std::chrono_literals;
+
+// The shortest a request may stay unanswered
+auto constexpr minTimeout = 250ms;
+
+PeerFetchWindows::PeerFetchWindows(
+    clock_type& clock,
+    clock_type::duration maxTimeout)
+    : clock_(clock)
+    , maxTimeout_(std::max<clock_type::duration>(maxTimeout, minTimeout))
+{
+}
+
+std::vector<std::pair<Peer::id_t, std::vector<PeerFetchWindows::Node>>>
+PeerFetchWindows::assign(
+    std::vector<Node> const& nodes,
+    std::vector<Peer::id_t> const& peers)
+{
+    std::vector<std::pair<Peer::id_t, std::vector<Node>>> result;
+
+    expire();
+
+    // The room in the window of each peer which is not busy
+    std::vector<std::pair<Peer::id_t, std::size_t>> room;
+    for (auto const peer : peers)
+    {
+        auto const& w = windows_[peer];
+        if (w.requested.empty() &&
+            std::none_of(room.begin(), room.end(), [peer](auto const& r) {
+                return r.first == peer;
+            }))
+        {
+            room.emplace_back(peer, w.size);
+        }
+    }
+    if (room.empty())
+        return result;
+
+    // Group the nodes by the branch of the root they are under
+    std::array<std::vector<Node const*>, 16> subtrees;
+    for (auto const& node : nodes)
+    {
+        if (inFlight_.count(node.second))
+            continue;
+        auto const branch =
+            node.first.isRoot() ? 0 : *node.first.getNodeID().begin() >> 4;
+        subtrees[branch].push_back(&node);
+    }
+
+    // Hand each subtree to the peer with the most room, spilling over to
+    // the next one if it does not fit.
+    std::vector<std::vector<Node>> assigned(room.size());
+    for (auto const& subtree : subtrees)
+    {
+        auto it = subtree.begin();
+        while (it != subtree.end())
+        {
+            auto const best = std::max_element(
+                room.begin(), room.end(), [](auto const& a, auto const& b) {
+                    return a.second < b.second;
+                });
+            if (best->second == 0)
+                break;
+
+            auto const n = std::min<std::size_t>(
+                best->second, std::distance(it, subtree.end()));
+            auto& out = assigned[std::distance(room.begin(), best)];
+            for (auto const end = it + n; it != end; ++it)
+                out.push_back(**it);
+            best->second -= n;
+        }
+    }
+
+    auto const now = clock_.now();
+    for (std::size_t i = 0; i < room.size(); ++i)
+    {
+        if (assigned[i].empty())
+            continue;
+
+        auto const peer = room[i].first;
+        auto& w = windows_[peer];
+        w.sent = now;
+        for (auto const& node : assigned[i])
+            inFlight_.emplace(node.second, peer);
+        w.requested = assigned[i];
+        result.emplace_back(peer, std::move(assigned[i]));
+    }
+
+    return result;
+}
+
+std::size_t
+PeerFetchWindows::capacity(std::vector<Peer::id_t> const& peers) const
+{
+    std::size_t total = 0;
+    for (auto const peer : peers)
+    {
+        auto const it = windows_.find(peer);
+        if (it == windows_.end())
+            total += initialWindow;
+        else if (it->second.requested.empty())
+            total += it->second.size;
+    }
+    return total;
+}
+
+bool
+PeerFetchWindows::onReply(
+    Peer::id_t peer,
+    SHAMapNodeID const& first,
+    std::size_t received)
+{
+    auto const it = windows_.find(peer);
+    if (it == windows_.end())
+        return false;
+
+    auto& w = it->second;
+    bool const answersLate =
+        std::find(w.late.begin(), w.late.end(), first) != w.late.end();
+    bool const answersRequest = std::any_of(
+        w.requested.begin(), w.requested.end(), [&first](Node const& node) {
+            return node.first == first;
+        });
+    if (answersLate)
+        w.late.clear();
+    if (!answersRequest)
+        return false;
+
+    auto const asked = w.requested.size();
+    auto const rtt =
+        std::max<clock_type::duration>(clock_.now() - w.sent, 1ms);
+    release(peer, w);
+
+    // The same node was asked for again, so this may be the late answer
+    // to the request given up on. Its timing tells nothing.
+    if (answersLate)
+        return true;
+
+    w.minRoundTrip = w.minRoundTrip ? std::min(*w.minRoundTrip, rtt) : rtt;
+    w.roundTrip = w.roundTrip ? (*w.roundTrip * 7 + rtt) / 8 : rtt;
+
+    if (received < asked)
+    {
+        // The peer could not answer in full
+        w.size = std::max(minWindow, w.size / 2);
+    }
+    else if (rtt <= 2 * *w.minRoundTrip)
+    {
+        // The peer is not queueing our requests. Ask for more, unless the
+        // window was not filled in the first place.
+        if (asked >= w.size)
+            w.size = std::min(maxWindow, w.size * 2);
+    }
+    else
+    {
+        // Ask for what the peer delivers in two of its best round trips
+        w.size = std::clamp<std::size_t>(
+            2 * asked * w.minRoundTrip->count() / rtt.count(),
+            minWindow,
+            maxWindow);
+    }
+    return true;
+}
+
+std::size_t
+PeerFetchWindows::expire()
+{
+    auto const now = clock_.now();
+    std::size_t released = 0;
+    for (auto& [peer, w] : windows_)
+    {
+        if (w.requested.empty() || now - w.sent < timeout(w))
+            continue;
+
+        released += w.requested.size();
+        giveUp(peer, w);
+    }
+    return released;
+}
+
+void
+PeerFetchWindows::reset()
+{
+    for (auto& [peer, w] : windows_)
+    {
+        if (!w.requested.empty())
+            giveUp(peer, w);
+    }
+}
+
+std::size_t
+PeerFetchWindows::window(Peer::id_t peer) const
+{
+    auto const it = windows_.find(peer);
+    return it == windows_.end() ? initialWindow : it->second.size;
+}
+
+std::optional<std::chrono::milliseconds>
+PeerFetchWindows::roundTrip(Peer::id_t peer) const
+{
+    auto const it = windows_.find(peer);
+    if (it == windows_.end() || !it->second.roundTrip)
+        return std::nullopt;
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        *it->second.roundTrip);
+}
+
+void
+PeerFetchWindows::release(Peer::id_t peer, Window& w)
+{
+    for (auto const& node : w.requested)
+    {
+        auto const it = inFlight_.find(node.second);
+        if (it != inFlight_.end() && it->second == peer)
+            inFlight_.erase(it);
+    }
+    w.requested.clear();
+}
+
+void
+PeerFetchWindows::giveUp(Peer::id_t peer, Window& w)
+{
+    w.late.clear();
+    w.late.reserve(w.requested.size());
+    for (auto const& node : w.requested)
+        w.late.push_back(node.first);
+    release(peer, w);
+    w.size = std::max(minWindow, w.size / 2);
+}
+
+PeerFetchWindows::clock_type::duration
+PeerFetchWindows::timeout(Window const& w) const
+{
+    if (!w.roundTrip)
+        return maxTimeout_;
+    return std::clamp<clock_type::duration>(
+        4 * *w.roundTrip, minTimeout, maxTimeout_);
+}
+
+}  // namespace ripple
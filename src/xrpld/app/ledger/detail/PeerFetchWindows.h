@@ -0,0 +1,175 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_LEDGER_PEERFETCHWINDOWS_H_INCLUDED
+#define RIPPLE_APP_LEDGER_PEERFETCHWINDOWS_H_INCLUDED
+
+#include <xrpld/overlay/Peer.h>
+#include <xrpld/shamap/SHAMapNodeID.h>
+#include <xrpl/basics/UnorderedContainers.h>
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/beast/clock/abstract_clock.h>
+
+#include <chrono>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ripple {
+
+/** Spreads requests for missing SHAMap nodes over several peers.
+
+    Each peer has a window: the number of nodes it is asked for at once.
+    A peer has at most one request outstanding. The window grows while the
+    peer answers in about its best round trip time. It shrinks towards the
+    peer's measured rate when the round trip time rises, or when a request
+    goes unanswered.
+
+    Each node is asked of one peer at a time, so peers do not send the same
+    nodes. Nodes are handed out by subtree, so one peer tends to walk a
+    whole branch of the map.
+*/
+class PeerFetchWindows
+{
+public:
+    using clock_type = beast::abstract_clock<std::chrono::steady_clock>;
+    using Node = std::pair<SHAMapNodeID, uint256>;
+
+    /** The fewest nodes asked of a peer at once. */
+    static constexpr std::size_t minWindow = 12;
+
+    /** The window of a peer which has not answered yet. */
+    static constexpr std::size_t initialWindow = 128;
+
+    /** The most nodes asked of a peer at once.
+
+        With a query depth of one, a peer answers for each node with up to
+        seventeen, and replies are capped at 8192 nodes.
+    */
+    static constexpr std::size_t maxWindow = 512;
+
+    /**
+        @param clock Measures round trip times.
+        @param maxTimeout The longest a request may stay unanswered.
+    */
+    PeerFetchWindows(clock_type& clock, clock_type::duration maxTimeout);
+
+    /** Choose which peers to ask for which nodes.
+
+        Nodes which are already asked of a peer, and peers which already
+        have a request outstanding, are skipped. The requests returned are
+        recorded as outstanding.
+
+        @param nodes The missing nodes.
+        @param peers The peers which may be asked.
+        @return The nodes to ask of each peer.
+    */
+    std::vector<std::pair<Peer::id_t, std::vector<Node>>>
+    assign(
+        std::vector<Node> const& nodes,
+        std::vector<Peer::id_t> const& peers);
+
+    /** The number of nodes the given peers may be asked for right now. */
+    std::size_t
+    capacity(std::vector<Peer::id_t> const& peers) const;
+
+    /** A peer sent nodes.
+
+        A peer answers the nodes of a request in the order they were asked
+        for, so the first node of a reply tells which request it answers.
+        A reply which does not answer the outstanding request of the peer
+        is ignored. One which might also answer a request given up on does
+        not count towards the round trip time.
+
+        @param peer The peer.
+        @param first The ID of the first node in the reply.
+        @param received The number of nodes in the reply.
+        @return true if the reply answered the outstanding request.
+    */
+    bool
+    onReply(
+        Peer::id_t peer,
+        SHAMapNodeID const& first,
+        std::size_t received);
+
+    /** Give up on requests which have taken much longer than usual.
+
+        A request times out after four of its peer's round trips, within
+        bounds. Its nodes may be asked of another peer.
+
+        @return The number of nodes released.
+    */
+    std::size_t
+    expire();
+
+    /** Give up on every outstanding request. */
+    void
+    reset();
+
+    /** The number of nodes the peer is asked for at once. */
+    std::size_t
+    window(Peer::id_t peer) const;
+
+    /** The peer's smoothed round trip time, if it has answered. */
+    std::optional<std::chrono::milliseconds>
+    roundTrip(Peer::id_t peer) const;
+
+    /** The number of nodes asked of peers and not yet answered. */
+    std::size_t
+    outstanding() const
+    {
+        return inFlight_.size();
+    }
+
+private:
+    struct Window
+    {
+        std::size_t size = initialWindow;
+        // The nodes of the outstanding request
+        std::vector<Node> requested;
+        // The nodes of the last request given up on, which may yet be
+        // answered
+        std::vector<SHAMapNodeID> late;
+        clock_type::time_point sent;
+        std::optional<clock_type::duration> minRoundTrip;
+        std::optional<clock_type::duration> roundTrip;
+    };
+
+    // Forget the outstanding request of a peer
+    void
+    release(Peer::id_t peer, Window& w);
+
+    // Stop waiting for the outstanding request of a peer
+    void
+    giveUp(Peer::id_t peer, Window& w);
+
+    clock_type::duration
+    timeout(Window const& w) const;
+
+    clock_type& clock_;
+    clock_type::duration const maxTimeout_;
+    std::unordered_map<Peer::id_t, Window> windows_;
+    // Each outstanding node, and the peer it was asked of
+    hash_map<uint256, Peer::id_t> inFlight_;
+};
+
+}  // namespace ripple
+
+#endif
@@ -0,0 +1,108 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_MISC_BOOKPAGECACHE_H_INCLUDED
+#define RIPPLE_APP_MISC_BOOKPAGECACHE_H_INCLUDED
+
+#include <xrpld/ledger/ReadView.h>
+#include <xrpl/json/json_value.h>
+#include <xrpl/protocol/Book.h>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <tuple>
+
+namespace ripple {
+
+/** Caches the offers computed for book_offers requests.
+
+    A page of offers, including the funded amounts, depends only on the
+    ledger it was computed from, the book, the requested limit, and on
+    whether the taker is charged the issuer's transfer fee. Ledgers handed
+    out to RPC are immutable snapshots, so a page never needs to be
+    invalidated while its ledger is alive: an entry is tied to the snapshot
+    it was built from and is discarded once that snapshot is released.
+
+    Clients that poll the same books repeatedly within a ledger, and
+    snapshots sent to new book subscribers, are served from the cache
+    instead of walking the order book again.
+*/
+class BookPageCache
+{
+public:
+    /** @param capacity Maximum number of pages to retain. */
+    explicit BookPageCache(std::size_t capacity = 1024);
+
+    BookPageCache(BookPageCache const&) = delete;
+    BookPageCache&
+    operator=(BookPageCache const&) = delete;
+
+    /** Return the cached offers for the page, if any. */
+    std::optional<Json::Value>
+    fetch(
+        std::shared_ptr<ReadView const> const& view,
+        Book const& book,
+        bool chargeTransferFee,
+        unsigned int limit);
+
+    /** Remember the offers computed for the page. */
+    void
+    insert(
+        std::shared_ptr<ReadView const> const& view,
+        Book const& book,
+        bool chargeTransferFee,
+        unsigned int limit,
+        Json::Value const& offers);
+
+    /** Return the number of cached pages. */
+    std::size_t
+    size() const;
+
+    /** Return the fraction of lookups that were served from the cache. */
+    float
+    getHitRate() const;
+
+private:
+    using Key = std::tuple<ReadView const*, Book, bool, unsigned int>;
+
+    struct Entry
+    {
+        // Detects that the ledger was released and its address reused.
+        std::weak_ptr<ReadView const> view;
+        Json::Value offers;
+    };
+
+    // Drops entries for released ledgers, then everything if still full.
+    void
+    sweep();
+
+    std::size_t const capacity_;
+    std::mutex mutable mutex_;
+    std::map<Key, Entry> entries_;
+
+    std::atomic<std::uint64_t> hits_{0};
+    std::atomic<std::uint64_t> misses_{0};
+};
+
+}  // namespace ripple
+
+#endif
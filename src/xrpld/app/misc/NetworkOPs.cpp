@@ -29,6 +29,7 @@
 #include <xrpld/app/ledger/TransactionMaster.h>
 #include <xrpld/app/main/LoadManager.h>
 #include <xrpld/app/misc/AmendmentTable.h>
+#include <xrpld/app/misc/BookPageCache.h>
 #include <xrpld/app/misc/DeliverMax.h>
 #include <xrpld/app/misc/HashRouter.h>
 #include <xrpld/app/misc/LoadFeeTrack.h>
@@ -40,6 +41,7 @@
 #include <xrpld/app/misc/detail/AccountTxPaging.h>
 #include <xrpld/app/rdb/backend/SQLiteDatabase.h>
 #include <xrpld/app/tx/apply.h>
+#include <xrpld/app/tx/applySteps.h>
 #include <xrpld/consensus/Consensus.h>
 #include <xrpld/consensus/ConsensusParms.h>
 #include <xrpld/overlay/Cluster.h>
@@ -91,6 +93,8 @@ class NetworkOPsImp final : public NetworkOPs
         bool const admin;
         bool const local;
         FailHard const failType;
+        // Run before the transaction joined the batch, if it was.
+        std::optional<PreflightResult> const preflightResult;
         bool applied = false;
         TER result;
 
@@ -98,13 +102,30 @@ class NetworkOPsImp final : public NetworkOPs
             std::shared_ptr<Transaction> t,
             bool a,
             bool l,
-            FailHard f)
-            : transaction(t), admin(a), local(l), failType(f)
+            FailHard f,
+            std::optional<PreflightResult> pf = std::nullopt)
+            : transaction(t)
+            , admin(a)
+            , local(l)
+            , failType(f)
+            , preflightResult(std::move(pf))
         {
             assert(local || failType == FailHard::no);
         }
     };
 
+    static ApplyFlags
+    applyFlags(bool admin, FailHard failType)
+    {
+        ApplyFlags flags = tapNONE;
+        if (admin)
+            flags |= tapUNLIMITED;
+
+        if (failType == FailHard::yes)
+            flags |= tapFAIL_HARD;
+        return flags;
+    }
+
     /**
      * Synchronization states for transaction batches.
      */
@@ -292,12 +313,14 @@ public:
      * @param transaction Transaction object.
      * @param bUnliimited Whether a privileged client connection submitted it.
      * @param failType fail_hard setting from transaction submission.
+     * @param pfresult The result of preflight for the transaction.
      */
     void
     doTransactionSync(
         std::shared_ptr<Transaction> transaction,
         bool bUnlimited,
-        FailHard failType);
+        FailHard failType,
+        std::optional<PreflightResult> pfresult);
 
     /**
      * For transactions not submitted by a locally connected client, fire and
@@ -307,12 +330,14 @@ public:
      * @param transaction Transaction object
      * @param bUnlimited Whether a privileged client connection submitted it.
      * @param failType fail_hard setting from transaction submission.
+     * @param pfresult The result of preflight for the transaction.
      */
     void
     doTransactionAsync(
         std::shared_ptr<Transaction> transaction,
         bool bUnlimited,
-        FailHard failtype);
+        FailHard failtype,
+        std::optional<PreflightResult> pfresult);
 
     /**
      * Apply transactions in batches. Continue until none are queued.
@@ -351,6 +376,12 @@ public:
         Json::Value const& jvMarker,
         Json::Value& jvResult) override;
 
+    float
+    getBookPageCacheHitRate() const override
+    {
+        return bookPageCache_.getHitRate();
+    }
+
     // Ledger proposal/close functions.
     bool
     processTrustedProposal(RCLCxPeerPos proposal) override;
@@ -709,6 +740,8 @@ private:
 
     std::unique_ptr<LocalTxs> m_localTX;
 
+    BookPageCache bookPageCache_;
+
     std::recursive_mutex mSubLock;
 
     std::atomic<OperatingMode> mMode;
@@ -1218,25 +1251,44 @@ NetworkOPsImp::processTransaction(
     // canonicalize can change our pointer
     app_.getMasterTransaction().canonicalize(&transaction);
 
+    // Preflight reads no ledger state, so run it here, on whichever thread
+    // is processing the transaction, rather than in the batch, under the
+    // master lock. The batch runs it again if the rules have changed.
+    std::optional<PreflightResult> pfresult;
+    {
+        auto const& rules = view->rules();
+        STAmountSO stAmountSO{rules.enabled(fixSTAmountCanonicalize)};
+        NumberSO stNumberSO{rules.enabled(fixUniversalNumber)};
+        pfresult.emplace(preflight(
+            app_,
+            rules,
+            *transaction->getSTransaction(),
+            applyFlags(bUnlimited, failType),
+            m_journal));
+    }
+
     if (bLocal)
-        doTransactionSync(transaction, bUnlimited, failType);
+        doTransactionSync(
+            transaction, bUnlimited, failType, std::move(pfresult));
     else
-        doTransactionAsync(transaction, bUnlimited, failType);
+        doTransactionAsync(
+            transaction, bUnlimited, failType, std::move(pfresult));
 }
 
 void
 NetworkOPsImp::doTransactionAsync(
     std::shared_ptr<Transaction> transaction,
     bool bUnlimited,
-    FailHard failType)
+    FailHard failType,
+    std::optional<PreflightResult> pfresult)
 {
     std::lock_guard lock(mMutex);
 
     if (transaction->getApplying())
         return;
 
-    mTransactions.push_back(
-        TransactionStatus(transaction, bUnlimited, false, failType));
+    mTransactions.push_back(TransactionStatus(
+        transaction, bUnlimited, false, failType, std::move(pfresult)));
     transaction->setApplying();
 
     if (mDispatchState == DispatchState::none)
@@ -1253,14 +1305,15 @@ void
 NetworkOPsImp::doTransactionSync(
     std::shared_ptr<Transaction> transaction,
     bool bUnlimited,
-    FailHard failType)
+    FailHard failType,
+    std::optional<PreflightResult> pfresult)
 {
     std::unique_lock<std::mutex> lock(mMutex);
 
     if (!transaction->getApplying())
     {
-        mTransactions.push_back(
-            TransactionStatus(transaction, bUnlimited, true, failType));
+        mTransactions.push_back(TransactionStatus(
+            transaction, bUnlimited, true, failType, std::move(pfresult)));
         transaction->setApplying();
     }
 
@@ -1328,15 +1381,19 @@ NetworkOPsImp::apply(std::unique_lock<std::mutex>& batchLock)
                 for (TransactionStatus& e : transactions)
                 {
                     // we check before adding to the batch
-                    ApplyFlags flags = tapNONE;
-                    if (e.admin)
-                        flags |= tapUNLIMITED;
-
-                    if (e.failType == FailHard::yes)
-                        flags |= tapFAIL_HARD;
-
-                    auto const result = app_.getTxQ().apply(
-                        app_, view, e.transaction->getSTransaction(), flags, j);
+                    auto const result = e.preflightResult
+                        ? app_.getTxQ().apply(
+                              app_,
+                              view,
+                              e.transaction->getSTransaction(),
+                              *e.preflightResult,
+                              j)
+                        : app_.getTxQ().apply(
+                              app_,
+                              view,
+                              e.transaction->getSTransaction(),
+                              applyFlags(e.admin, e.failType),
+                              j);
                     e.result = result.first;
                     e.applied = result.second;
                     changed = changed || result.second;
@@ -2478,6 +2535,9 @@ NetworkOPsImp::getServerInfo(bool human, bool admin, bool counters)
     if (fp != 0)
         info[jss::fetch_pack] = Json::UInt(fp);
 
+    if (auto backfill = m_ledgerMaster.getBackfillJson(); !backfill.isNull())
+        info[jss::history_backfill] = std::move(backfill);
+
     info[jss::peers] = Json::UInt(app_.overlay().size());
 
     Json::Value lastClose = Json::objectValue;
@@ -4083,6 +4143,19 @@ NetworkOPsImp::getBookPage(
     Json::Value const& jvMarker,
     Json::Value& jvResult)
 {  // CAUTION: This is the old get book page logic
+
+    // The only way the taker affects the page is whether the issuer's
+    // transfer fee applies to the offers.
+    bool const chargeTransferFee = uTakerID != book.out.account;
+    unsigned int const requestedLimit = iLimit;
+
+    if (auto cached = bookPageCache_.fetch(
+            lpLedger, book, chargeTransferFee, requestedLimit))
+    {
+        jvResult[jss::offers] = std::move(*cached);
+        return;
+    }
+
     Json::Value& jvOffers =
         (jvResult[jss::offers] = Json::Value(Json::arrayValue));
 
@@ -4211,7 +4284,7 @@ NetworkOPsImp::getBookPage(
 
                 if (rate != parityRate
                     // Have a tranfer fee.
-                    && uTakerID != book.out.account
+                    && chargeTransferFee
                     // Not taking offers of own IOUs.
                     && book.out.account != uOfferOwnerID)
                 // Offer owner not issuing ownfunds
@@ -4271,6 +4344,9 @@ NetworkOPsImp::getBookPage(
         }
     }
 
+    bookPageCache_.insert(
+        lpLedger, book, chargeTransferFee, requestedLimit, jvOffers);
+
     //  jvResult[jss::marker]  = Json::Value(Json::arrayValue);
     //  jvResult[jss::nodes]   = Json::Value(Json::arrayValue);
 }
@@ -164,6 +164,10 @@ public:
         Json::Value const& jvMarker,
         Json::Value& jvResult) = 0;
 
+    /** Return the percentage of book pages served from the cache. */
+    virtual float
+    getBookPageCacheHitRate() const = 0;
+
     //--------------------------------------------------------------------------
 
     // ledger proposal/close functions
@@ -117,6 +117,27 @@ SHAMapStoreImp::SHAMapStoreImp(
 
     get_if_exists(section, "online_delete", deleteInterval_);
 
+    if (Section const& cold{
+            config.section(ConfigSection::coldNodeDatabase())};
+        !cold.empty())
+    {
+        if (deleteInterval_)
+        {
+            Throw<std::runtime_error>(
+                "online_delete can not be used with [" +
+                ConfigSection::coldNodeDatabase() + "]");
+        }
+
+        if (!get_if_exists(cold, "hot_ledgers", deleteInterval_) ||
+            !deleteInterval_)
+        {
+            Throw<std::runtime_error>(
+                "Missing hot_ledgers in [" +
+                ConfigSection::coldNodeDatabase() + "]");
+        }
+        tiered_ = true;
+    }
+
     if (deleteInterval_)
     {
         // Configuration that affects the behavior of online delete
@@ -133,7 +154,8 @@ SHAMapStoreImp::SHAMapStoreImp(
         if (get_if_exists(section, "recovery_wait_seconds", temp))
             recoveryWaitTime_ = std::chrono::seconds{temp};
 
-        get_if_exists(section, "advisory_delete", advisoryDelete_);
+        if (!tiered_)
+            get_if_exists(section, "advisory_delete", advisoryDelete_);
 
         auto const minInterval = config.standalone()
             ? minimumDeletionIntervalSA_
@@ -141,11 +163,12 @@ SHAMapStoreImp::SHAMapStoreImp(
         if (deleteInterval_ < minInterval)
         {
             Throw<std::runtime_error>(
-                "online_delete must be at least " +
-                std::to_string(minInterval));
+                std::string(tiered_ ? "hot_ledgers" : "online_delete") +
+                " must be at least " + std::to_string(minInterval));
         }
 
-        if (config.LEDGER_HISTORY > deleteInterval_)
+        // With a cold backend, all of the history stays available
+        if (!tiered_ && config.LEDGER_HISTORY > deleteInterval_)
         {
             Throw<std::runtime_error>(
                 "online_delete must not be less than ledger_history "
@@ -190,6 +213,18 @@ SHAMapStoreImp::makeNodeStore(int readThreads)
             state_db_.setState(state);
         }
 
+        std::shared_ptr<NodeStore::Backend> coldBackend;
+        if (tiered_)
+        {
+            coldBackend = NodeStore::Manager::instance().make_Backend(
+                app_.config().section(ConfigSection::coldNodeDatabase()),
+                megabytes(app_.config().getValueFor(
+                    SizedItem::burstSize, std::nullopt)),
+                scheduler_,
+                app_.logs().journal(nodeStoreName_));
+            coldBackend->open();
+        }
+
         // Create NodeStore with two backends to allow online deletion of
         // data
         auto dbr = std::make_unique<NodeStore::DatabaseRotatingImp>(
@@ -197,6 +232,7 @@ SHAMapStoreImp::makeNodeStore(int readThreads)
             readThreads,
             std::move(writableBackend),
             std::move(archiveBackend),
+            std::move(coldBackend),
             nscfg,
             app_.logs().journal(nodeStoreName_));
         fdRequired_ += dbr->fdRequired();
@@ -245,15 +281,19 @@ SHAMapStoreImp::fdRequired() const
 }
 
 bool
-SHAMapStoreImp::copyNode(std::uint64_t& nodeCount, SHAMapTreeNode const& node)
+SHAMapStoreImp::copyNode(CopyProgress& progress, SHAMapTreeNode const& node)
 {
-    // Copy a single record from node to dbRotating_
-    dbRotating_->fetchNodeObject(
-        node.getHash().as_uint256(),
-        0,
-        NodeStore::FetchType::synchronous,
-        true);
-    if (!(++nodeCount % checkHealthInterval_))
+    // The node is already in memory, so serialize it rather than reading
+    // the same record back from the archive backend.
+    Serializer s;
+    node.serializeWithPrefix(s);
+    progress.batch.push_back(NodeObject::createObject(
+        hotACCOUNT_NODE, std::move(s.modData()), node.getHash().as_uint256()));
+
+    if (progress.batch.size() >= NodeStore::batchWritePreallocationSize)
+        flushCopy(progress);
+
+    if (!(++progress.nodes % checkHealthInterval_))
     {
         if (healthWait() == stopping)
             return false;
@@ -262,6 +302,13 @@ SHAMapStoreImp::copyNode(std::uint64_t& nodeCount, SHAMapTreeNode const& node)
     return true;
 }
 
+void
+SHAMapStoreImp::flushCopy(CopyProgress& progress)
+{
+    progress.written += dbRotating_->copyToWritable(progress.batch);
+    progress.batch.clear();
+}
+
 void
 SHAMapStoreImp::run()
 {
@@ -318,12 +365,15 @@ SHAMapStoreImp::run()
                 << app_.getOPs().strOperatingMode(false) << " age "
                 << ledgerMaster_->getValidatedLedgerAge().count() << 's';
 
-            clearPrior(lastRotated);
+            // Ledger history is kept when data moves to a cold backend
+            if (!tiered_)
+                clearPrior(lastRotated);
             if (healthWait() == stopping)
                 return;
 
             JLOG(journal_.debug()) << "copying ledger " << validatedSeq;
-            std::uint64_t nodeCount = 0;
+            CopyProgress progress;
+            progress.batch.reserve(NodeStore::batchWritePreallocationSize);
 
             try
             {
@@ -331,8 +381,9 @@ SHAMapStoreImp::run()
                     std::bind(
                         &SHAMapStoreImp::copyNode,
                         this,
-                        std::ref(nodeCount),
+                        std::ref(progress),
                         std::placeholders::_1));
+                flushCopy(progress);
             }
             catch (SHAMapMissingNode const& e)
             {
@@ -346,7 +397,7 @@ SHAMapStoreImp::run()
                 return;
             // Only log if we completed without a "health" abort
             JLOG(journal_.debug()) << "copied ledger " << validatedSeq
-                                   << " nodecount " << nodeCount;
+                                   << " nodecount " << progress.nodes;
 
             JLOG(journal_.debug()) << "freshening caches";
             freshenCaches();
@@ -355,6 +406,19 @@ SHAMapStoreImp::run()
             // Only log if we completed without a "health" abort
             JLOG(journal_.debug()) << validatedSeq << " freshened caches";
 
+            std::uint64_t migrated = 0;
+            if (tiered_)
+            {
+                JLOG(journal_.debug()) << "migrating archive to cold backend";
+                auto const result = dbRotating_->migrateArchive(
+                    [this]() { return healthWait() == keepGoing; });
+                if (!result)
+                    return;
+                migrated = *result;
+                JLOG(journal_.debug()) << validatedSeq << " migrated "
+                                       << migrated << " objects";
+            }
+
             JLOG(journal_.trace()) << "Making a new backend";
             auto newBackend = makeBackendRotating();
             JLOG(journal_.debug())
@@ -379,7 +443,14 @@ SHAMapStoreImp::run()
                     return std::move(newBackend);
                 });
 
-            JLOG(journal_.warn()) << "finished rotation " << validatedSeq;
+            // Only nodes missing from the writable backend are written, as
+            // before. What the copy saves is reading those nodes back from
+            // the archive, since they are serialized from memory instead.
+            JLOG(journal_.warn())
+                << "finished rotation " << validatedSeq << " nodes "
+                << progress.nodes << " written " << progress.written
+                << " already present " << progress.nodes - progress.written
+                << " migrated " << migrated;
         }
     }
 }
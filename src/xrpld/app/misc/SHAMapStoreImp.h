@@ -100,6 +100,9 @@ private:
     int fdRequired_ = 0;
 
     std::uint32_t deleteInterval_ = 0;
+    // Rotated out data moves to the [node_db_cold] backend instead of
+    // being deleted, and ledger history is kept.
+    bool tiered_ = false;
     bool advisoryDelete_ = false;
     std::uint32_t deleteBatch_ = 100;
     std::chrono::milliseconds backOff_{100};
@@ -128,8 +131,9 @@ public:
     std::uint32_t
     clampFetchDepth(std::uint32_t fetch_depth) const override
     {
-        return deleteInterval_ ? std::min(fetch_depth, deleteInterval_)
-                               : fetch_depth;
+        return deleteInterval_ && !tiered_
+            ? std::min(fetch_depth, deleteInterval_)
+            : fetch_depth;
     }
 
     std::unique_ptr<NodeStore::Database>
@@ -177,9 +181,19 @@ public:
     minimumOnline() const override;
 
 private:
+    // Nodes being carried over to the writable backend before a rotation
+    struct CopyProgress
+    {
+        NodeStore::Batch batch;
+        std::uint64_t nodes = 0;
+        std::uint64_t written = 0;
+    };
+
     // callback for visitNodes
     bool
-    copyNode(std::uint64_t& nodeCount, SHAMapTreeNode const& node);
+    copyNode(CopyProgress& progress, SHAMapTreeNode const& node);
+    void
+    flushCopy(CopyProgress& progress);
     void
     run();
     void
@@ -23,6 +23,7 @@
 #include <xrpld/app/tx/applySteps.h>
 #include <xrpld/ledger/ApplyView.h>
 #include <xrpld/ledger/OpenView.h>
+#include <xrpl/basics/UnorderedContainers.h>
 #include <xrpl/protocol/RippleLedgerHash.h>
 #include <xrpl/protocol/STTx.h>
 #include <xrpl/protocol/SeqProxy.h>
@@ -275,6 +276,26 @@ public:
         ApplyFlags flags,
         beast::Journal j);
 
+    /**
+        Add a new transaction to the open ledger, hold it in the queue,
+        or reject it, continuing from a preflight run beforehand.
+
+        If the view's rules differ from those preflight ran under, it
+        is run again.
+
+        @param pfresult The result of preflight for `tx`, which also
+                        supplies the `ApplyFlags`.
+
+        @return As the overload above.
+    */
+    std::pair<TER, bool>
+    apply(
+        Application& app,
+        OpenView& view,
+        std::shared_ptr<STTx const> const& tx,
+        PreflightResult const& pfresult,
+        beast::Journal j);
+
     /**
         Fill the new open ledger with transactions from the queue.
 
@@ -736,6 +757,18 @@ private:
         OpenView& view,
         std::shared_ptr<STTx const> const& tx,
         ApplyFlags flags,
+        PreflightResult const* precomputed,
+        beast::Journal j);
+
+    // Implements both overloads of apply. If precomputed is null,
+    // preflight runs here.
+    std::pair<TER, bool>
+    apply(
+        Application& app,
+        OpenView& view,
+        std::shared_ptr<STTx const> const& tx,
+        ApplyFlags flags,
+        PreflightResult const* precomputed,
         beast::Journal j);
 
     // Helper function that removes a replaced entry in _byFee.
@@ -752,7 +785,8 @@ private:
     using FeeMultiSet = boost::intrusive::
         multiset<MaybeTx, FeeHook, boost::intrusive::compare<OrderCandidates>>;
 
-    using AccountMap = std::map<AccountID, TxQAccount>;
+    // Account IDs are chosen by whoever submits, so the hash is seeded.
+    using AccountMap = hardened_hash_map<AccountID, TxQAccount>;
 
     /// Setup parameters used to control the behavior of the queue
     Setup const setup_;
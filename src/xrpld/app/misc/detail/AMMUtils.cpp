@@ -185,8 +185,12 @@ ammAccountHolds(
     }
     else if (auto const sle = view.read(
                  keylet::line(ammAccountID, issue.account, issue.currency));
-             sle &&
-             !isFrozen(view, ammAccountID, issue.currency, issue.account))
+             sle && !isGlobalFrozen(view, issue.account) &&
+             // As isFrozen, but without reading the trust line again.
+             (issue.account == ammAccountID ||
+              !sle->isFlag(
+                  (issue.account > ammAccountID) ? lsfHighFreeze
+                                                 : lsfLowFreeze)))
     {
         auto amount = (*sle)[sfBalance];
         if (ammAccountID > issue.account)
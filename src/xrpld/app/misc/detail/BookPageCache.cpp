@@ -0,0 +1,105 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpld/app/misc/BookPageCache.h>
+
+namespace ripple {
+
+BookPageCache::BookPageCache(std::size_t capacity) : capacity_(capacity)
+{
+}
+
+std::optional<Json::Value>
+BookPageCache::fetch(
+    std::shared_ptr<ReadView const> const& view,
+    Book const& book,
+    bool chargeTransferFee,
+    unsigned int limit)
+{
+    std::lock_guard lock(mutex_);
+
+    auto const it =
+        entries_.find(Key{view.get(), book, chargeTransferFee, limit});
+
+    if (it == entries_.end())
+    {
+        ++misses_;
+        return std::nullopt;
+    }
+
+    if (it->second.view.lock() != view)
+    {
+        // The ledger this page was built from is gone.
+        entries_.erase(it);
+        ++misses_;
+        return std::nullopt;
+    }
+
+    ++hits_;
+    return it->second.offers;
+}
+
+void
+BookPageCache::insert(
+    std::shared_ptr<ReadView const> const& view,
+    Book const& book,
+    bool chargeTransferFee,
+    unsigned int limit,
+    Json::Value const& offers)
+{
+    std::lock_guard lock(mutex_);
+
+    if (entries_.size() >= capacity_)
+        sweep();
+
+    entries_.insert_or_assign(
+        Key{view.get(), book, chargeTransferFee, limit}, Entry{view, offers});
+}
+
+std::size_t
+BookPageCache::size() const
+{
+    std::lock_guard lock(mutex_);
+    return entries_.size();
+}
+
+float
+BookPageCache::getHitRate() const
+{
+    auto const hits = hits_.load();
+    auto const total = hits + misses_.load();
+    return total == 0 ? 0 : static_cast<float>(hits) * 100 / total;
+}
+
+void
+BookPageCache::sweep()
+{
+    for (auto it = entries_.begin(); it != entries_.end();)
+    {
+        if (it->second.view.expired())
+            it = entries_.erase(it);
+        else
+            ++it;
+    }
+
+    if (entries_.size() >= capacity_)
+        entries_.clear();
+}
+
+}  // namespace ripple
@@ -29,6 +29,7 @@
 #include <algorithm>
 #include <limits>
 #include <numeric>
+#include <vector>
 
 namespace ripple {
 
@@ -717,13 +718,43 @@ TxQ::apply(
     std::shared_ptr<STTx const> const& tx,
     ApplyFlags flags,
     beast::Journal j)
+{
+    return apply(app, view, tx, flags, nullptr, j);
+}
+
+std::pair<TER, bool>
+TxQ::apply(
+    Application& app,
+    OpenView& view,
+    std::shared_ptr<STTx const> const& tx,
+    PreflightResult const& pfresult,
+    beast::Journal j)
+{
+    assert(&pfresult.tx == tx.get());
+
+    // An amendment took effect after preflight ran.
+    if (pfresult.rules != view.rules())
+        return apply(app, view, tx, pfresult.flags, nullptr, j);
+
+    return apply(app, view, tx, pfresult.flags, &pfresult, j);
+}
+
+std::pair<TER, bool>
+TxQ::apply(
+    Application& app,
+    OpenView& view,
+    std::shared_ptr<STTx const> const& tx,
+    ApplyFlags flags,
+    PreflightResult const* precomputed,
+    beast::Journal j)
 {
     STAmountSO stAmountSO{view.rules().enabled(fixSTAmountCanonicalize)};
     NumberSO stNumberSO{view.rules().enabled(fixUniversalNumber)};
 
     // See if the transaction paid a high enough fee that it can go straight
     // into the ledger.
-    if (auto directApplied = tryDirectApply(app, view, tx, flags, j))
+    if (auto directApplied =
+            tryDirectApply(app, view, tx, flags, precomputed, j))
         return *directApplied;
 
     // If we get past tryDirectApply() without returning then we expect
@@ -736,7 +767,11 @@ TxQ::apply(
     // See if the transaction is valid, properly formed,
     // etc. before doing potentially expensive queue
     // replace and multi-transaction operations.
-    auto const pfresult = preflight(app, view.rules(), *tx, flags, j);
+    std::optional<PreflightResult> preflighted;
+    if (!precomputed)
+        precomputed =
+            &preflighted.emplace(preflight(app, view.rules(), *tx, flags, j));
+    auto const& pfresult = *precomputed;
     if (pfresult.ter != tesSUCCESS)
         return {pfresult.ter, false};
 
@@ -1557,24 +1592,37 @@ TxQ::accept(Application& app, OpenView& view)
     parentHash_ = parentHash;
 #endif
     // byFee_ doesn't "own" the candidate objects inside it, so it's
-    // perfectly safe to wipe it and start over, repopulating from
-    // byAccount_.
+    // perfectly safe to wipe it and start over.
     //
-    // In the absence of a "re-sort the list in place" function, this
-    // was the fastest method tried to repopulate the list.
-    // Other methods included: create a new list and moving items over one at a
-    // time, create a new list and merge the old list into it.
+    // The new parent hash only changes the order among transactions paying
+    // the same fee level, and byFee_ is already ordered by fee level. So
+    // take the candidates out in order, re-sort each run of equal fee
+    // levels, and append them in their final order, which costs constant
+    // time per candidate rather than a search of the tree.
+    std::vector<MaybeTx*> candidates;
+    candidates.reserve(byFee_.size());
+    for (auto& candidate : byFee_)
+        candidates.push_back(&candidate);
     byFee_.clear();
 
     MaybeTx::parentHashComp = parentHash;
 
-    for (auto& [_, account] : byAccount_)
+    auto const byNewOrder = [](MaybeTx const* lhs, MaybeTx const* rhs) {
+        return OrderCandidates{}(*lhs, *rhs);
+    };
+    for (auto run = candidates.begin(); run != candidates.end();)
     {
-        for (auto& [_, candidate] : account.transactions)
-        {
-            byFee_.insert(candidate);
-        }
+        auto const feeLevel = (*run)->feeLevel;
+        auto const end =
+            std::find_if(run, candidates.end(), [feeLevel](MaybeTx const* c) {
+                return c->feeLevel != feeLevel;
+            });
+        std::sort(run, end, byNewOrder);
+        run = end;
     }
+
+    for (auto candidate : candidates)
+        byFee_.push_back(*candidate);
     assert(byFee_.size() == startingSize);
 
     return ledgerChanged;
@@ -1659,6 +1707,7 @@ TxQ::tryDirectApply(
     OpenView& view,
     std::shared_ptr<STTx const> const& tx,
     ApplyFlags flags,
+    PreflightResult const* precomputed,
     beast::Journal j)
 {
     auto const account = (*tx)[sfAccount];
@@ -1693,8 +1742,9 @@ TxQ::tryDirectApply(
         JLOG(j_.trace()) << "Applying transaction " << transactionID
                          << " to open ledger.";
 
-        auto const [txnResult, didApply] =
-            ripple::apply(app, view, *tx, flags, j);
+        auto const [txnResult, didApply] = precomputed
+            ? ripple::apply(app, view, *precomputed)
+            : ripple::apply(app, view, *tx, flags, j);
 
         JLOG(j_.trace()) << "New transaction " << transactionID
                          << (didApply ? " applied successfully with "
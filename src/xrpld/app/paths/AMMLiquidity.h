@@ -60,6 +60,10 @@ private:
     Issue const issueOut_;
     // Initial AMM pool balances
     TAmounts<TIn, TOut> const initialBalances_;
+    // The first Fibonacci sequence offer depends only on the initial
+    // balances, so it is computed once for each rounding mode.
+    mutable std::optional<TAmounts<TIn, TOut>> initialFibSeqOffer_;
+    mutable Number::rounding_mode initialFibSeqRound_{};
     beast::Journal const j_;
 
 public:
@@ -168,6 +168,32 @@ PathRequest::updateComplete()
     }
 }
 
+LedgerIndex
+PathRequest::recordUpdate(LedgerIndex index)
+{
+    std::lock_guard sl(mIndexLock);
+
+    LedgerIndex skipped = 0;
+    if (lastUpdated_ != 0 && index > lastUpdated_ + 1)
+        skipped = index - lastUpdated_ - 1;
+    if (index > lastUpdated_)
+        lastUpdated_ = index;
+    return skipped;
+}
+
+std::pair<AccountID, Currency>
+PathRequest::getSourceKey()
+{
+    std::lock_guard sl(mLock);
+    return {raSrcAccount.value_or(AccountID{}), saDstAmount.getCurrency()};
+}
+
+bool
+PathRequest::isUnlimited() const
+{
+    return consumer_.isUnlimited();
+}
+
 bool
 PathRequest::isValid(std::shared_ptr<RippleLineCache> const& crCache)
 {
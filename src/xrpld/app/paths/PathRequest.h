@@ -85,6 +85,26 @@ public:
     void
     updateComplete();
 
+    /** Records that the request was updated with ledger `index`.
+
+        @return The number of ledgers since the previous update with which
+                the request was not updated.
+    */
+    LedgerIndex
+    recordUpdate(LedgerIndex index);
+
+    /** The source account and destination currency of the request.
+
+        Requests with the same key explore the same trust lines and order
+        books, so they are best updated one after another.
+    */
+    std::pair<AccountID, Currency>
+    getSourceKey();
+
+    /** Returns true if the client is not subject to resource limits. */
+    bool
+    isUnlimited() const;
+
     std::pair<bool, Json::Value>
     doCreate(std::shared_ptr<RippleLineCache> const&, Json::Value const&);
 
@@ -159,6 +179,7 @@ private:
 
     std::recursive_mutex mIndexLock;
     LedgerIndex mLastIndex;
+    LedgerIndex lastUpdated_ = 0;
     bool mInProgress;
 
     int iLevel;
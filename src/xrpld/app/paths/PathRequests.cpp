@@ -20,6 +20,7 @@
 #include <xrpld/app/ledger/LedgerMaster.h>
 #include <xrpld/app/main/Application.h>
 #include <xrpld/app/paths/PathRequests.h>
+#include <xrpld/app/paths/detail/PathWork.h>
 #include <xrpld/core/JobQueue.h>
 #include <xrpl/basics/Log.h>
 #include <xrpl/protocol/ErrorCodes.h>
@@ -27,6 +28,11 @@
 #include <xrpl/protocol/jss.h>
 #include <xrpl/resource/Fees.h>
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
 
 namespace ripple {
 
@@ -55,15 +61,134 @@ PathRequests::getLineCache(
     {
         JLOG(mJournal.debug())
             << "getLineCache creating new cache for " << lgrSeq;
+        // Trust lines which the new ledger did not change can be carried
+        // over from the cache of its parent.
+        auto const parent = lineCache ? lineCache : seedCache_;
+        if (parent && parent->canSeed(*ledger))
+            lineCache = std::make_shared<RippleLineCache>(
+                ledger, *parent, app_.journal("RippleLineCache"));
+        else
+            lineCache = std::make_shared<RippleLineCache>(
+                ledger, app_.journal("RippleLineCache"));
         // Assign to the local before the member, because the member is a
         // weak_ptr, and will immediately discard it if there are no other
         // references.
-        lineCache_ = lineCache = std::make_shared<RippleLineCache>(
-            ledger, app_.journal("RippleLineCache"));
+        lineCache_ = lineCache;
     }
+    if (authoritative)
+        seedCache_ = lineCache;
     return lineCache;
 }
 
+// Requests from one source account for one currency explore the same trust
+// lines and order books, so each such group is updated in sequence by one
+// thread. Groups of admin and non-admin requests alternate, so that neither
+// kind waits for all the requests of the other.
+static std::vector<std::vector<PathRequest::pointer>>
+scheduleRequests(std::vector<PathRequest::wptr> const& requests)
+{
+    using Key = std::pair<AccountID, Currency>;
+
+    std::array<std::vector<std::vector<PathRequest::pointer>>, 2> groups;
+    std::array<std::map<Key, std::size_t>, 2> indexes;
+
+    for (auto const& wr : requests)
+    {
+        auto request = wr.lock();
+        if (!request)
+            continue;
+
+        auto const kind = request->isUnlimited() ? 0 : 1;
+        auto const [it, inserted] =
+            indexes[kind].emplace(request->getSourceKey(), groups[kind].size());
+        if (inserted)
+            groups[kind].emplace_back();
+        groups[kind][it->second].push_back(std::move(request));
+    }
+
+    std::vector<std::vector<PathRequest::pointer>> schedule;
+    schedule.reserve(groups[0].size() + groups[1].size());
+    for (std::size_t i = 0;
+         i < std::max(groups[0].size(), groups[1].size());
+         ++i)
+    {
+        for (auto& kind : groups)
+        {
+            if (i < kind.size())
+                schedule.push_back(std::move(kind[i]));
+        }
+    }
+    return schedule;
+}
+
+bool
+PathRequests::updateRequest(
+    PathRequest::pointer const& request,
+    std::shared_ptr<RippleLineCache> const& cache,
+    bool newOnly,
+    std::atomic<int>& processed)
+{
+    auto getSubscriber =
+        [](PathRequest::pointer const& request) -> InfoSub::pointer {
+        if (auto ipSub = request->getSubscriber();
+            ipSub && ipSub->getRequest() == request)
+        {
+            return ipSub;
+        }
+        request->doAborting();
+        return nullptr;
+    };
+
+    auto continueCallback = [&getSubscriber, &request]() {
+        // This callback is used by doUpdate to determine whether to
+        // continue working. If getSubscriber returns null, that
+        // indicates that this request is no longer relevant.
+        return (bool)getSubscriber(request);
+    };
+
+    auto const seq = cache->getLedger()->seq();
+    if (!request->needsUpdate(newOnly, seq))
+        return true;
+
+    auto const start = std::chrono::steady_clock::now();
+    auto report = [&]() {
+        mUpdate.notify(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start));
+        if (auto const skipped = request->recordUpdate(seq))
+            mSkipped += skipped;
+        ++processed;
+    };
+
+    if (auto ipSub = getSubscriber(request))
+    {
+        if (!ipSub->getConsumer().warn())
+        {
+            // Release the shared ptr to the subscriber so that
+            // it can be freed if the client disconnects, and
+            // thus fail to lock later.
+            ipSub.reset();
+            Json::Value update =
+                request->doUpdate(cache, false, continueCallback);
+            request->updateComplete();
+            update[jss::type] = "path_find";
+            if ((ipSub = getSubscriber(request)))
+            {
+                ipSub->send(update, false);
+                report();
+                return true;
+            }
+        }
+    }
+    else if (request->hasCompletion())
+    {
+        // One-shot request with completion function
+        request->doUpdate(cache, false);
+        request->updateComplete();
+        report();
+    }
+    return false;
+}
+
 void
 PathRequests::updateAll(std::shared_ptr<ReadView const> const& inLedger)
 {
@@ -81,108 +206,85 @@ PathRequests::updateAll(std::shared_ptr<ReadView const> const& inLedger)
     }
 
     bool newRequests = app_.getLedgerMaster().isNewPathRequest();
-    bool mustBreak = false;
+    std::atomic<bool> mustBreak = false;
 
     JLOG(mJournal.trace()) << "updateAll seq=" << cache->getLedger()->seq()
                            << ", " << requests.size() << " requests";
 
-    int processed = 0, removed = 0;
-
-    auto getSubscriber =
-        [](PathRequest::pointer const& request) -> InfoSub::pointer {
-        if (auto ipSub = request->getSubscriber();
-            ipSub && ipSub->getRequest() == request)
-        {
-            return ipSub;
-        }
-        request->doAborting();
-        return nullptr;
-    };
+    std::atomic<int> processed = 0;
+    int removed = 0;
 
     do
     {
         JLOG(mJournal.trace()) << "updateAll looping";
-        for (auto const& wr : requests)
-        {
-            if (app_.getJobQueue().isStopping())
-                break;
 
-            auto request = wr.lock();
-            bool remove = true;
-            JLOG(mJournal.trace())
-                << "updateAll request " << (request ? "" : "not ") << "found";
+        auto const schedule = scheduleRequests(requests);
+        std::atomic<std::size_t> next = 0;
+        std::mutex m;
+        std::vector<PathRequest::pointer> finished;
+        mustBreak = false;
 
-            if (request)
+        auto work = [&](bool) {
+            try
             {
-                auto continueCallback = [&getSubscriber, &request]() {
-                    // This callback is used by doUpdate to determine whether to
-                    // continue working. If getSubscriber returns null, that
-                    // indicates that this request is no longer relevant.
-                    return (bool)getSubscriber(request);
-                };
-                if (!request->needsUpdate(
-                        newRequests, cache->getLedger()->seq()))
-                    remove = false;
-                else
+                for (std::size_t i = next++; i < schedule.size(); i = next++)
                 {
-                    if (auto ipSub = getSubscriber(request))
+                    for (auto const& request : schedule[i])
                     {
-                        if (!ipSub->getConsumer().warn())
+                        if (mustBreak || app_.getJobQueue().isStopping())
+                            return;
+
+                        if (!updateRequest(
+                                request, cache, newRequests, processed))
                         {
-                            // Release the shared ptr to the subscriber so that
-                            // it can be freed if the client disconnects, and
-                            // thus fail to lock later.
-                            ipSub.reset();
-                            Json::Value update = request->doUpdate(
-                                cache, false, continueCallback);
-                            request->updateComplete();
-                            update[jss::type] = "path_find";
-                            if ((ipSub = getSubscriber(request)))
-                            {
-                                ipSub->send(update, false);
-                                remove = false;
-                                ++processed;
-                            }
+                            std::lock_guard lock(m);
+                            finished.push_back(request);
                         }
-                    }
-                    else if (request->hasCompletion())
-                    {
-                        // One-shot request with completion function
-                        request->doUpdate(cache, false);
-                        request->updateComplete();
-                        ++processed;
+
+                        // We weren't handling new requests and then
+                        // there was a new request
+                        if (!newRequests &&
+                            app_.getLedgerMaster().isNewPathRequest())
+                            mustBreak = true;
                     }
                 }
             }
-
-            if (remove)
+            catch (...)
             {
-                std::lock_guard sl(mLock);
-
-                // Remove any dangling weak pointers or weak
-                // pointers that refer to this path request.
-                auto ret = std::remove_if(
-                    requests_.begin(),
-                    requests_.end(),
-                    [&removed, &request](auto const& wl) {
-                        auto r = wl.lock();
-
-                        if (r && r != request)
-                            return false;
-                        ++removed;
-                        return true;
-                    });
-
-                requests_.erase(ret, requests_.end());
+                // Stop the other threads. The exception reaches our caller
+                // once they are done.
+                mustBreak = true;
+                throw;
             }
+        };
 
-            mustBreak =
-                !newRequests && app_.getLedgerMaster().isNewPathRequest();
+        detail::doPathWork(
+            app_.getJobQueue(),
+            std::min<std::size_t>(
+                std::max(app_.config().PATH_UPDATE_THREADS, 1),
+                schedule.size()),
+            work);
 
-            // We weren't handling new requests and then
-            // there was a new request
-            if (mustBreak)
-                break;
+        {
+            std::lock_guard sl(mLock);
+
+            // Remove any dangling weak pointers or weak
+            // pointers that refer to finished path requests.
+            auto ret = std::remove_if(
+                requests_.begin(),
+                requests_.end(),
+                [&removed, &finished](auto const& wl) {
+                    auto r = wl.lock();
+
+                    if (r &&
+                        std::find(finished.begin(), finished.end(), r) ==
+                            finished.end())
+                        return false;
+                    ++removed;
+                    return true;
+                });
+
+            requests_.erase(ret, requests_.end());
         }
 
         if (mustBreak)
@@ -208,14 +310,18 @@ PathRequests::updateAll(std::shared_ptr<ReadView const> const& inLedger)
             std::lock_guard sl(mLock);
 
             if (requests_.empty())
+            {
+                // Don't keep trust lines in memory with nobody to use them.
+                seedCache_.reset();
                 break;
+            }
             requests = requests_;
             lastCache = cache;
             cache = getLineCache(cache->getLedger(), false);
         }
     } while (!app_.getJobQueue().isStopping());
 
-    JLOG(mJournal.debug()) << "updateAll complete: " << processed
+    JLOG(mJournal.debug()) << "updateAll complete: " << processed.load()
                            << " processed and " << removed << " removed";
 }
 
@@ -42,10 +42,16 @@ public:
     {
         mFast = collector->make_event("pathfind_fast");
         mFull = collector->make_event("pathfind_full");
+        mUpdate = collector->make_event("pathfind_update");
+        mSkipped = collector->make_counter("pathfind_ledgers_skipped");
     }
 
     /** Update all of the contained PathRequest instances.
 
+        Requests are split into groups by source account and destination
+        currency, and the groups are updated by up to [path_update_threads]
+        threads. Groups of admin and non-admin requests are taken in turn.
+
         @param ledger Ledger we are pathfinding in.
      */
     void
@@ -102,11 +108,24 @@ private:
     void
     insertPathRequest(PathRequest::pointer const&);
 
+    // Update one request with the ledger of the cache. Returns false if the
+    // request should be removed.
+    bool
+    updateRequest(
+        PathRequest::pointer const& request,
+        std::shared_ptr<RippleLineCache> const& cache,
+        bool newOnly,
+        std::atomic<int>& processed);
+
     Application& app_;
     beast::Journal mJournal;
 
     beast::insight::Event mFast;
     beast::insight::Event mFull;
+    // Time taken by each update of a request in updateAll
+    beast::insight::Event mUpdate;
+    // Ledgers with which a request was not updated between two updates
+    beast::insight::Counter mSkipped;
 
     // Track all requests
     std::vector<PathRequest::wptr> requests_;
@@ -114,6 +133,11 @@ private:
     // Use a RippleLineCache
     std::weak_ptr<RippleLineCache> lineCache_;
 
+    // The cache of the last ledger passed to updateAll. It is kept between
+    // ledgers, while there are requests, so the next cache can reuse the
+    // trust lines the next ledger did not change.
+    std::shared_ptr<RippleLineCache> seedCache_;
+
     std::atomic<int> mLastIdentifier;
 
     std::recursive_mutex mutable mLock;
@@ -22,6 +22,7 @@
 #include <xrpld/app/paths/Pathfinder.h>
 #include <xrpld/app/paths/RippleCalc.h>
 #include <xrpld/app/paths/RippleLineCache.h>
+#include <xrpld/app/paths/detail/PathWork.h>
 #include <xrpld/app/paths/detail/PathfinderUtils.h>
 #include <xrpld/core/Config.h>
 #include <xrpld/core/JobQueue.h>
@@ -30,6 +31,8 @@
 #include <xrpl/basics/join.h>
 #include <xrpl/json/to_string.h>
 
+#include <atomic>
+#include <optional>
 #include <tuple>
 
 /*
@@ -509,31 +512,76 @@ Pathfinder::rankPaths(
         return largestAmount(mDstAmount);
     }();
 
-    for (int i = 0; i < paths.size(); ++i)
+    // Each candidate is measured by an independent simulation in its own
+    // sandbox over the same read-only ledger, so the candidates are spread
+    // over a few threads. Results are stored by index, which keeps the
+    // ranking independent of the order in which the measurements finish.
+    struct Liquidity
     {
-        if (continueCallback && !continueCallback())
-            return;
-        auto const& currentPath = paths[i];
-        if (!currentPath.empty())
+        std::optional<TER> result;
+        STAmount amount;
+        uint64_t quality = 0;
+    };
+    std::vector<Liquidity> liquidity(paths.size());
+
+    std::atomic<std::size_t> next = 0;
+    std::atomic<bool> stopped = false;
+
+    // Only the calling thread consults continueCallback, since it may not
+    // be safe to call from elsewhere.
+    auto measure = [&](bool callback) {
+        try
         {
-            STAmount liquidity;
-            uint64_t uQuality;
-            auto const resultCode = getPathLiquidity(
-                currentPath, saMinDstAmount, liquidity, uQuality);
-            if (resultCode != tesSUCCESS)
+            for (std::size_t i = next++; i < paths.size() && !stopped;
+                 i = next++)
             {
-                JLOG(j_.debug())
-                    << "findPaths: dropping : " << transToken(resultCode)
-                    << ": " << currentPath.getJson(JsonOptions::none);
+                if (callback && continueCallback && !continueCallback())
+                {
+                    stopped = true;
+                    return;
+                }
+                if (paths[i].empty())
+                    continue;
+                auto& l = liquidity[i];
+                l.result = getPathLiquidity(
+                    paths[i], saMinDstAmount, l.amount, l.quality);
             }
-            else
-            {
-                JLOG(j_.debug()) << "findPaths: quality: " << uQuality << ": "
-                                 << currentPath.getJson(JsonOptions::none);
+        }
+        catch (...)
+        {
+            stopped = true;
+            throw;
+        }
+    };
 
-                rankedPaths.push_back(
-                    {uQuality, currentPath.size(), liquidity, i});
-            }
+    detail::doPathWork(
+        app_.getJobQueue(),
+        std::min<std::size_t>(
+            std::max(app_.config().PATH_RANK_THREADS, 1), paths.size()),
+        measure);
+
+    if (stopped)
+        return;
+
+    for (int i = 0; i < paths.size(); ++i)
+    {
+        auto const& currentPath = paths[i];
+        auto const& l = liquidity[i];
+        if (!l.result)
+            continue;
+        if (*l.result != tesSUCCESS)
+        {
+            JLOG(j_.debug())
+                << "findPaths: dropping : " << transToken(*l.result) << ": "
+                << currentPath.getJson(JsonOptions::none);
+        }
+        else
+        {
+            JLOG(j_.debug()) << "findPaths: quality: " << l.quality << ": "
+                             << currentPath.getJson(JsonOptions::none);
+
+            rankedPaths.push_back(
+                {l.quality, currentPath.size(), l.amount, i});
         }
     }
 
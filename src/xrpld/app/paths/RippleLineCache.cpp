@@ -20,6 +20,9 @@
 #include <xrpld/app/paths/RippleLineCache.h>
 #include <xrpld/app/paths/TrustLine.h>
 #include <xrpld/ledger/OpenView.h>
+#include <xrpl/basics/UnorderedContainers.h>
+#include <xrpl/protocol/SField.h>
+#include <xrpl/protocol/STObject.h>
 
 namespace ripple {
 
@@ -31,6 +34,60 @@ RippleLineCache::RippleLineCache(
     JLOG(journal_.debug()) << "created for ledger " << ledger_->info().seq;
 }
 
+RippleLineCache::RippleLineCache(
+    std::shared_ptr<ReadView const> const& ledger,
+    RippleLineCache& parent,
+    beast::Journal j)
+    // The reused keys hold hashes made by the parent's hasher
+    : hasher_(parent.hasher_), ledger_(ledger), journal_(j)
+{
+    assert(parent.canSeed(*ledger_));
+
+    // Every account on either side of a trust line changed by this ledger
+    hash_set<AccountID> touched;
+    for (auto const& item : ledger_->txs)
+    {
+        auto const& meta = item.second;
+        if (!meta)
+            continue;
+
+        for (auto const& node : meta->getFieldArray(sfAffectedNodes))
+        {
+            if (node.getFieldU16(sfLedgerEntryType) != ltRIPPLE_STATE)
+                continue;
+
+            auto const& field =
+                node.getFName() == sfCreatedNode ? sfNewFields : sfFinalFields;
+            if (auto const data =
+                    dynamic_cast<STObject const*>(node.peekAtPField(field));
+                data && data->isFieldPresent(sfLowLimit) &&
+                data->isFieldPresent(sfHighLimit))
+            {
+                touched.insert(data->getFieldAmount(sfLowLimit).getIssuer());
+                touched.insert(data->getFieldAmount(sfHighLimit).getIssuer());
+            }
+        }
+    }
+
+    std::lock_guard sl(parent.mLock);
+    lines_.reserve(parent.lines_.size());
+    for (auto const& [key, lines] : parent.lines_)
+    {
+        if (touched.count(key.account_))
+            continue;
+        lines_.emplace(key, lines);
+        if (lines)
+            totalLineCount_ += lines->size();
+    }
+    reused_ = lines_.size();
+
+    JLOG(journal_.debug()) << "created for ledger " << ledger_->info().seq
+                           << " reusing " << reused_ << " of "
+                           << parent.lines_.size() << " accounts from ledger "
+                           << parent.ledger_->info().seq << ", "
+                           << touched.size() << " accounts changed";
+}
+
 RippleLineCache::~RippleLineCache()
 {
     JLOG(journal_.debug()) << "destroyed for ledger " << ledger_->info().seq
@@ -125,4 +182,26 @@ RippleLineCache::getRippleLines(
     return it->second;
 }
 
+bool
+RippleLineCache::canSeed(ReadView const& ledger) const
+{
+    return !ledger.open() && !ledger_->open() &&
+        ledger.seq() == ledger_->seq() + 1 &&
+        ledger.info().parentHash == ledger_->info().hash;
+}
+
+std::size_t
+RippleLineCache::getAccountCount() const
+{
+    std::lock_guard sl(mLock);
+    return lines_.size();
+}
+
+std::size_t
+RippleLineCache::getLineCount() const
+{
+    std::lock_guard sl(mLock);
+    return totalLineCount_;
+}
+
 }  // namespace ripple
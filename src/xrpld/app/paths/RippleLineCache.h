@@ -39,6 +39,22 @@ public:
     explicit RippleLineCache(
         std::shared_ptr<ReadView const> const& l,
         beast::Journal j);
+
+    /** Create a cache for a ledger which directly follows the ledger of
+        another cache.
+
+        The trust lines already loaded by `parent` are shared with the new
+        cache, except for the accounts on either side of a trust line that
+        the transactions in `l` created, modified or deleted. Those are read
+        again from `l` on demand.
+
+        @pre parent.canSeed(*l)
+    */
+    RippleLineCache(
+        std::shared_ptr<ReadView const> const& l,
+        RippleLineCache& parent,
+        beast::Journal j);
+
     ~RippleLineCache();
 
     std::shared_ptr<ReadView const> const&
@@ -62,8 +78,33 @@ public:
     std::shared_ptr<std::vector<PathFindTrustLine>>
     getRippleLines(AccountID const& accountID, LineDirection direction);
 
+    /** Returns true if a cache for `ledger` can be built from this one.
+
+        Both ledgers must be closed and `ledger` must be the direct child of
+        the ledger of this cache, so that its transaction metadata lists
+        every trust line which changed.
+    */
+    bool
+    canSeed(ReadView const& ledger) const;
+
+    /** The number of accounts with trust lines loaded. */
+    std::size_t
+    getAccountCount() const;
+
+    /** The number of trust lines held by the cache. */
+    std::size_t
+    getLineCount() const;
+
+    /** The number of accounts whose trust lines were reused from the parent
+        cache instead of being read from the ledger. */
+    std::size_t
+    getReusedCount() const
+    {
+        return reused_;
+    }
+
 private:
-    std::mutex mLock;
+    std::mutex mutable mLock;
 
     ripple::hardened_hash<> hasher_;
     std::shared_ptr<ReadView const> ledger_;
@@ -125,6 +166,7 @@ private:
         AccountKey::Hash>
         lines_;
     std::size_t totalLineCount_ = 0;
+    std::size_t reused_ = 0;
 };
 
 }  // namespace ripple
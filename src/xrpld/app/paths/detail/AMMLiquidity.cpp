@@ -59,13 +59,18 @@ TAmounts<TIn, TOut>
 AMMLiquidity<TIn, TOut>::generateFibSeqOffer(
     TAmounts<TIn, TOut> const& balances) const
 {
-    TAmounts<TIn, TOut> cur{};
-
-    cur.in = toAmount<TIn>(
-        getIssue(balances.in),
-        InitialFibSeqPct * initialBalances_.in,
-        Number::rounding_mode::upward);
-    cur.out = swapAssetIn(initialBalances_, cur.in, tradingFee_);
+    if (!initialFibSeqOffer_ || initialFibSeqRound_ != Number::getround())
+    {
+        TAmounts<TIn, TOut> first{};
+        first.in = toAmount<TIn>(
+            getIssue(balances.in),
+            InitialFibSeqPct * initialBalances_.in,
+            Number::rounding_mode::upward);
+        first.out = swapAssetIn(initialBalances_, first.in, tradingFee_);
+        initialFibSeqOffer_ = first;
+        initialFibSeqRound_ = Number::getround();
+    }
+    TAmounts<TIn, TOut> cur = *initialFibSeqOffer_;
 
     if (ammContext_.curIters() == 0)
         return cur;
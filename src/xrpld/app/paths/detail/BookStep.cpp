@@ -930,11 +930,10 @@ template <class TIn, class TOut, class TDerived>
 std::optional<std::variant<Quality, AMMOffer<TIn, TOut>>>
 BookStep<TIn, TOut, TDerived>::tip(ReadView const& view) const
 {
-    // This can be simplified (and sped up) if directories are never empty.
-    Sandbox sb(&view, tapNONE);
-    BookTip bt(sb, book_);
-    auto const lobQuality =
-        bt.step(j_) ? std::optional<Quality>(bt.quality()) : std::nullopt;
+    // The strands are ranked by the tip of every book on every iteration,
+    // so only read what the quality needs: not the offer itself, and not
+    // through a Sandbox, which would copy each entry it reads.
+    auto const lobQuality = bookTipQuality(view, book_);
     // Multi-path offer generates an offer with the quality
     // calculated from the offer size and the quality is constant in this case.
     // Single path offer quality changes with the offer size. Spot price quality
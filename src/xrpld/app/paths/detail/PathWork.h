@@ -0,0 +1,108 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_PATHS_DETAIL_PATHWORK_H_INCLUDED
+#define RIPPLE_APP_PATHS_DETAIL_PATHWORK_H_INCLUDED
+
+#include <xrpld/core/JobQueue.h>
+
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+namespace ripple {
+namespace detail {
+
+/** Spread a share of path finding work over several JobQueue threads.
+
+    `f` is called on the calling thread, and in up to `count - 1` jobs.
+    Each call should take items from state shared by all of them until none
+    is left, so that the calling thread can do all of the work by itself.
+    `f` is passed `true` on the calling thread only.
+
+    Once the calling thread runs out of work, jobs which haven't started
+    return without calling `f`. Only jobs which are already running are
+    waited for, so this can't deadlock when every JobQueue thread is busy,
+    even with other calls to this function.
+
+    If any call to `f` throws, the first exception is rethrown after every
+    call has returned. `f` should stop the others early when it throws.
+*/
+template <class F>
+void
+doPathWork(JobQueue& jq, std::size_t count, F const& f)
+{
+    struct State
+    {
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool closed = false;
+        std::size_t running = 0;
+        std::exception_ptr exception;
+
+        void
+        call(F const& f, bool caller)
+        {
+            try
+            {
+                f(caller);
+            }
+            catch (...)
+            {
+                std::lock_guard lock(mutex);
+                if (!exception)
+                    exception = std::current_exception();
+            }
+        }
+    };
+
+    auto const state = std::make_shared<State>();
+
+    for (std::size_t i = 1; i < count; ++i)
+    {
+        // A job outlives this call if it starts too late, so it only
+        // touches `f` while it is counted as running.
+        jq.addJob(jtPATH_WORK, "PathWork", [state, &f]() {
+            {
+                std::lock_guard lock(state->mutex);
+                if (state->closed)
+                    return;
+                ++state->running;
+            }
+            state->call(f, false);
+            std::lock_guard lock(state->mutex);
+            if (--state->running == 0)
+                state->cv.notify_all();
+        });
+    }
+
+    state->call(f, true);
+
+    std::unique_lock lock(state->mutex);
+    state->closed = true;
+    state->cv.wait(lock, [&state] { return state->running == 0; });
+    if (state->exception)
+        std::rethrow_exception(state->exception);
+}
+
+}  // namespace detail
+}  // namespace ripple
+
+#endif
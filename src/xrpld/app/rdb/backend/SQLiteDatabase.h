@@ -27,6 +27,13 @@ namespace ripple {
 class SQLiteDatabase : public RelationalDatabase
 {
 public:
+    struct ReadPoolStats
+    {
+        std::size_t sessions = 0;
+        std::uint64_t checkouts = 0;
+        std::uint64_t waits = 0;
+    };
+
     /**
      * @brief getTransactionsMinLedgerSeq Returns the minimum ledger sequence
      *        stored in the Transactions table.
@@ -112,6 +119,18 @@ public:
         std::shared_ptr<Ledger const> const& ledger,
         bool current) = 0;
 
+    /**
+     * @brief saveValidatedLedgers Saves several ledgers into the database,
+     *        committing them together.
+     * @param ledgers The ledgers, in the order they should be written.
+     * @param current True if the ledgers are current.
+     * @return True if every ledger was saved successfully.
+     */
+    virtual bool
+    saveValidatedLedgers(
+        std::vector<std::shared_ptr<Ledger const>> const& ledgers,
+        bool current) = 0;
+
     /**
      * @brief getLimitedOldestLedgerInfo Returns the info of the oldest ledger
      *        whose sequence number is greater than or equal to the given
@@ -295,6 +314,16 @@ public:
     virtual uint32_t
     getKBUsedTransaction() = 0;
 
+    /**
+     * @brief getTransactionReadPoolStats Returns the number of read-only
+     *        sessions open against the transaction database, how many times
+     *        they were checked out, and how many checkouts had to wait
+     *        because every session was busy.
+     * @return Read pool counters.
+     */
+    virtual ReadPoolStats
+    getTransactionReadPoolStats() = 0;
+
     /**
      * @brief Closes the ledger database
      */
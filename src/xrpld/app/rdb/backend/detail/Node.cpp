@@ -80,7 +80,12 @@ makeLedgerDBs(
     {
         // transaction database
         auto tx{std::make_unique<DatabaseCon>(
-            setup, TxDBName, TxDBPragma, TxDBInit, checkpointerSetup)};
+            setup,
+            TxDBName,
+            TxDBPragma,
+            TxDBInit,
+            checkpointerSetup,
+            setup.readConnections)};
         tx->getSession() << boost::str(
             boost::format("PRAGMA cache_size=-%d;") %
             kilobytes(config.getValueFor(SizedItem::txnDBCache)));
@@ -183,10 +188,17 @@ getRowsMinMax(soci::session& session, TableType type)
     return res;
 }
 
-bool
-saveValidatedLedger(
-    DatabaseCon& ldgDB,
-    DatabaseCon& txnDB,
+/**
+ * @brief prepareValidatedLedger Performs the checks and node store writes that
+ *        precede saving a ledger to the SQL databases, and builds the
+ *        accepted ledger whose transactions will be indexed.
+ * @param app Application object.
+ * @param ledger The ledger.
+ * @param current True if ledger is current.
+ * @return The accepted ledger, or nullptr if some of its nodes are missing.
+ */
+static std::shared_ptr<AcceptedLedger>
+prepareValidatedLedger(
     Application& app,
     std::shared_ptr<Ledger const> const& ledger,
     bool current)
@@ -242,141 +254,226 @@ saveValidatedLedger(
         // Clients can now trust the database for information about this
         // ledger sequence.
         app.pendingSaves().finishWork(seq);
-        return false;
+        return {};
     }
 
+    return aLedger;
+}
+
+/**
+ * @brief saveTransactions Writes the transactions of an accepted ledger, and
+ *        the accounts they affect, using the given transaction database
+ *        session. The caller is responsible for the enclosing transaction.
+ * @param session Session with the transaction database.
+ * @param app Application object.
+ * @param aLedger The accepted ledger.
+ */
+static void
+saveTransactions(
+    soci::session& session,
+    Application& app,
+    AcceptedLedger const& aLedger)
+{
+    static boost::format deleteTrans1(
+        "DELETE FROM Transactions WHERE LedgerSeq = %u;");
+    static boost::format deleteTrans2(
+        "DELETE FROM AccountTransactions WHERE LedgerSeq = %u;");
+    static boost::format deleteAcctTrans(
+        "DELETE FROM AccountTransactions WHERE TransID = '%s';");
+
+    auto j = app.journal("Ledger");
+    auto const seq = aLedger.getLedger()->info().seq;
+
+    session << boost::str(deleteTrans1 % seq);
+    session << boost::str(deleteTrans2 % seq);
+
+    std::string const ledgerSeq(std::to_string(seq));
+
+    for (auto const& acceptedLedgerTx : aLedger)
     {
-        static boost::format deleteLedger(
-            "DELETE FROM Ledgers WHERE LedgerSeq = %u;");
-        static boost::format deleteTrans1(
-            "DELETE FROM Transactions WHERE LedgerSeq = %u;");
-        static boost::format deleteTrans2(
-            "DELETE FROM AccountTransactions WHERE LedgerSeq = %u;");
-        static boost::format deleteAcctTrans(
-            "DELETE FROM AccountTransactions WHERE TransID = '%s';");
+        uint256 transactionID = acceptedLedgerTx->getTransactionID();
+
+        std::string const txnId(to_string(transactionID));
+        std::string const txnSeq(std::to_string(acceptedLedgerTx->getTxnSeq()));
 
+        session << boost::str(deleteAcctTrans % transactionID);
+
+        auto const& accts = acceptedLedgerTx->getAffected();
+
+        if (!accts.empty())
         {
-            auto db = ldgDB.checkoutDb();
-            *db << boost::str(deleteLedger % seq);
-        }
+            std::string sql(
+                "INSERT INTO AccountTransactions "
+                "(TransID, Account, LedgerSeq, TxnSeq) VALUES ");
 
-        if (app.config().useTxTables())
+            // Try to make an educated guess on how much space we'll
+            // need for our arguments. In argument order we have: 64
+            // + 34 + 10 + 10 = 118 + 10 extra = 128 bytes
+            sql.reserve(sql.length() + (accts.size() * 128));
+
+            bool first = true;
+            for (auto const& account : accts)
+            {
+                if (!first)
+                    sql += ", ('";
+                else
+                {
+                    sql += "('";
+                    first = false;
+                }
+
+                sql += txnId;
+                sql += "','";
+                sql += toBase58(account);
+                sql += "',";
+                sql += ledgerSeq;
+                sql += ",";
+                sql += txnSeq;
+                sql += ")";
+            }
+            sql += ";";
+            JLOG(j.trace()) << "ActTx: " << sql;
+            session << sql;
+        }
+        else if (auto const& sleTxn = acceptedLedgerTx->getTxn();
+                 !isPseudoTx(*sleTxn))
         {
-            auto db = txnDB.checkoutDb();
+            // It's okay for pseudo transactions to not affect any
+            // accounts.  But otherwise...
+            JLOG(j.warn()) << "Transaction in ledger " << seq
+                           << " affects no accounts";
+            JLOG(j.warn()) << sleTxn->getJson(JsonOptions::none);
+        }
+
+        session
+            << (STTx::getMetaSQLInsertReplaceHeader() +
+                acceptedLedgerTx->getTxn()->getMetaSQL(
+                    seq, acceptedLedgerTx->getEscMeta()) +
+                ";");
 
-            soci::transaction tr(*db);
+        app.getMasterTransaction().inLedger(transactionID, seq);
+    }
+}
 
-            *db << boost::str(deleteTrans1 % seq);
-            *db << boost::str(deleteTrans2 % seq);
+bool
+saveValidatedLedgers(
+    DatabaseCon& ldgDB,
+    DatabaseCon& txnDB,
+    Application& app,
+    std::vector<std::shared_ptr<Ledger const>> const& ledgers,
+    bool current)
+{
+    // Do all the work that doesn't need the databases first, so that the
+    // SQL transactions below are held open for as short a time as possible.
+    std::vector<std::shared_ptr<AcceptedLedger>> accepted;
+    accepted.reserve(ledgers.size());
+    for (auto const& ledger : ledgers)
+    {
+        if (auto aLedger = prepareValidatedLedger(app, ledger, current))
+            accepted.push_back(std::move(aLedger));
+    }
 
-            std::string const ledgerSeq(std::to_string(seq));
+    if (accepted.empty())
+        return false;
 
-            for (auto const& acceptedLedgerTx : *aLedger)
-            {
-                uint256 transactionID = acceptedLedgerTx->getTransactionID();
+    {
+        static boost::format deleteLedger(
+            "DELETE FROM Ledgers WHERE LedgerSeq = %u;");
 
-                std::string const txnId(to_string(transactionID));
-                std::string const txnSeq(
-                    std::to_string(acceptedLedgerTx->getTxnSeq()));
+        auto db = ldgDB.checkoutDb();
+        soci::transaction tr(*db);
 
-                *db << boost::str(deleteAcctTrans % transactionID);
+        for (auto const& aLedger : accepted)
+            *db << boost::str(deleteLedger % aLedger->getLedger()->info().seq);
 
-                auto const& accts = acceptedLedgerTx->getAffected();
+        tr.commit();
+    }
 
-                if (!accts.empty())
-                {
-                    std::string sql(
-                        "INSERT INTO AccountTransactions "
-                        "(TransID, Account, LedgerSeq, TxnSeq) VALUES ");
-
-                    // Try to make an educated guess on how much space we'll
-                    // need for our arguments. In argument order we have: 64
-                    // + 34 + 10 + 10 = 118 + 10 extra = 128 bytes
-                    sql.reserve(sql.length() + (accts.size() * 128));
-
-                    bool first = true;
-                    for (auto const& account : accts)
-                    {
-                        if (!first)
-                            sql += ", ('";
-                        else
-                        {
-                            sql += "('";
-                            first = false;
-                        }
-
-                        sql += txnId;
-                        sql += "','";
-                        sql += toBase58(account);
-                        sql += "',";
-                        sql += ledgerSeq;
-                        sql += ",";
-                        sql += txnSeq;
-                        sql += ")";
-                    }
-                    sql += ";";
-                    JLOG(j.trace()) << "ActTx: " << sql;
-                    *db << sql;
-                }
-                else if (auto const& sleTxn = acceptedLedgerTx->getTxn();
-                         !isPseudoTx(*sleTxn))
-                {
-                    // It's okay for pseudo transactions to not affect any
-                    // accounts.  But otherwise...
-                    JLOG(j.warn()) << "Transaction in ledger " << seq
-                                   << " affects no accounts";
-                    JLOG(j.warn()) << sleTxn->getJson(JsonOptions::none);
-                }
+    if (app.config().useTxTables())
+    {
+        auto db = txnDB.checkoutDb();
 
-                *db
-                    << (STTx::getMetaSQLInsertReplaceHeader() +
-                        acceptedLedgerTx->getTxn()->getMetaSQL(
-                            seq, acceptedLedgerTx->getEscMeta()) +
-                        ";");
+        // A single transaction for the whole batch amortizes the cost of
+        // syncing the write-ahead log over all of its ledgers.
+        soci::transaction tr(*db);
 
-                app.getMasterTransaction().inLedger(transactionID, seq);
-            }
+        for (auto const& aLedger : accepted)
+            saveTransactions(*db, app, *aLedger);
 
-            tr.commit();
-        }
+        tr.commit();
+    }
 
-        {
-            static std::string addLedger(
-                R"sql(INSERT OR REPLACE INTO Ledgers
+    {
+        static std::string addLedger(
+            R"sql(INSERT OR REPLACE INTO Ledgers
                 (LedgerHash,LedgerSeq,PrevHash,TotalCoins,ClosingTime,PrevClosingTime,
                 CloseTimeRes,CloseFlags,AccountSetHash,TransSetHash)
             VALUES
                 (:ledgerHash,:ledgerSeq,:prevHash,:totalCoins,:closingTime,:prevClosingTime,
                 :closeTimeRes,:closeFlags,:accountSetHash,:transSetHash);)sql");
 
-            auto db(ldgDB.checkoutDb());
-
-            soci::transaction tr(*db);
-
-            auto const hash = to_string(ledger->info().hash);
-            auto const parentHash = to_string(ledger->info().parentHash);
-            auto const drops = to_string(ledger->info().drops);
-            auto const closeTime =
-                ledger->info().closeTime.time_since_epoch().count();
-            auto const parentCloseTime =
-                ledger->info().parentCloseTime.time_since_epoch().count();
-            auto const closeTimeResolution =
-                ledger->info().closeTimeResolution.count();
-            auto const closeFlags = ledger->info().closeFlags;
-            auto const accountHash = to_string(ledger->info().accountHash);
-            auto const txHash = to_string(ledger->info().txHash);
-
-            *db << addLedger, soci::use(hash), soci::use(seq),
-                soci::use(parentHash), soci::use(drops), soci::use(closeTime),
-                soci::use(parentCloseTime), soci::use(closeTimeResolution),
-                soci::use(closeFlags), soci::use(accountHash),
-                soci::use(txHash);
-
-            tr.commit();
+        auto db(ldgDB.checkoutDb());
+
+        soci::transaction tr(*db);
+
+        std::string hash;
+        LedgerIndex seq;
+        std::string parentHash;
+        std::string drops;
+        NetClock::rep closeTime;
+        NetClock::rep parentCloseTime;
+        NetClock::rep closeTimeResolution;
+        int closeFlags;
+        std::string accountHash;
+        std::string txHash;
+
+        // Prepare the insert once and execute it for every ledger.
+        soci::statement st =
+            (db->prepare << addLedger,
+             soci::use(hash),
+             soci::use(seq),
+             soci::use(parentHash),
+             soci::use(drops),
+             soci::use(closeTime),
+             soci::use(parentCloseTime),
+             soci::use(closeTimeResolution),
+             soci::use(closeFlags),
+             soci::use(accountHash),
+             soci::use(txHash));
+
+        for (auto const& aLedger : accepted)
+        {
+            auto const& info = aLedger->getLedger()->info();
+
+            hash = to_string(info.hash);
+            seq = info.seq;
+            parentHash = to_string(info.parentHash);
+            drops = to_string(info.drops);
+            closeTime = info.closeTime.time_since_epoch().count();
+            parentCloseTime = info.parentCloseTime.time_since_epoch().count();
+            closeTimeResolution = info.closeTimeResolution.count();
+            closeFlags = info.closeFlags;
+            accountHash = to_string(info.accountHash);
+            txHash = to_string(info.txHash);
+
+            st.execute(true);
         }
+
+        tr.commit();
     }
 
-    return true;
+    return accepted.size() == ledgers.size();
+}
+
+bool
+saveValidatedLedger(
+    DatabaseCon& ldgDB,
+    DatabaseCon& txnDB,
+    Application& app,
+    std::shared_ptr<Ledger const> const& ledger,
+    bool current)
+{
+    return saveValidatedLedgers(ldgDB, txnDB, app, {ledger}, current);
 }
 
 /**
@@ -1065,34 +1162,27 @@ accountTxPage(
     }
     else
     {
+        // Resume from the marker with a keyset predicate on the
+        // (LedgerSeq, TxnSeq) prefix of AcctTxIndex. This lets SQLite seek
+        // straight to the marker and walk the index in order, so the cost of
+        // a page is proportional to the page size rather than to the amount
+        // of history preceding the marker.
         const char* const compare = forward ? ">=" : "<=";
         const std::uint32_t minLedger =
-            forward ? findLedger + 1 : options.minLedger;
+            forward ? findLedger : options.minLedger;
         const std::uint32_t maxLedger =
-            forward ? options.maxLedger : findLedger - 1;
+            forward ? options.maxLedger : findLedger;
 
-        auto b58acct = toBase58(options.account);
         sql = boost::str(
-            boost::format((
-                R"(SELECT AccountTransactions.LedgerSeq,AccountTransactions.TxnSeq,
-            Status,RawTxn,TxnMeta
-            FROM AccountTransactions, Transactions WHERE
-            (AccountTransactions.TransID = Transactions.TransID AND
-            AccountTransactions.Account = '%s' AND
-            AccountTransactions.LedgerSeq BETWEEN %u AND %u)
-            UNION
-            SELECT AccountTransactions.LedgerSeq,AccountTransactions.TxnSeq,Status,RawTxn,TxnMeta
-            FROM AccountTransactions, Transactions WHERE
-            (AccountTransactions.TransID = Transactions.TransID AND
-            AccountTransactions.Account = '%s' AND
-            AccountTransactions.LedgerSeq = %u AND
-            AccountTransactions.TxnSeq %s %u)
-            ORDER BY AccountTransactions.LedgerSeq %s,
-            AccountTransactions.TxnSeq %s
-            LIMIT %u;
-            )")) %
-            b58acct % minLedger % maxLedger % b58acct % findLedger % compare %
-            findSeq % order % order % queryLimit);
+            boost::format(
+                prefix + (R"(AccountTransactions.LedgerSeq BETWEEN %u AND %u
+             AND (AccountTransactions.LedgerSeq, AccountTransactions.TxnSeq)
+             %s (%u, %u)
+             ORDER BY AccountTransactions.LedgerSeq %s,
+             AccountTransactions.TxnSeq %s
+             LIMIT %u;)")) %
+            toBase58(options.account) % minLedger % maxLedger % compare %
+            findLedger % findSeq % order % order % queryLimit);
     }
 
     {
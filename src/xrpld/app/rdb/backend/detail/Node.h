@@ -120,6 +120,24 @@ getRows(soci::session& session, TableType type);
 RelationalDatabase::CountMinMax
 getRowsMinMax(soci::session& session, TableType type);
 
+/**
+ * @brief saveValidatedLedgers Saves several ledgers into the database using
+ *        one SQL transaction per database for the whole batch.
+ * @param lgrDB Link to ledgers database.
+ * @param txnDB Link to transactions database.
+ * @param app Application object.
+ * @param ledgers The ledgers, in the order they should be written.
+ * @param current True if the ledgers are current.
+ * @return True if every ledger was saved successfully.
+ */
+bool
+saveValidatedLedgers(
+    DatabaseCon& ldgDB,
+    DatabaseCon& txnDB,
+    Application& app,
+    std::vector<std::shared_ptr<Ledger const>> const& ledgers,
+    bool current);
+
 /**
  * @brief saveValidatedLedger Saves ledger into database.
  * @param lgrDB Link to ledgers database.
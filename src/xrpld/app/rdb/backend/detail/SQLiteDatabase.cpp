@@ -97,6 +97,11 @@ public:
         std::shared_ptr<Ledger const> const& ledger,
         bool current) override;
 
+    bool
+    saveValidatedLedgers(
+        std::vector<std::shared_ptr<Ledger const>> const& ledgers,
+        bool current) override;
+
     std::optional<LedgerInfo>
     getLedgerInfoByIndex(LedgerIndex ledgerSeq) override;
 
@@ -169,6 +174,9 @@ public:
     std::uint32_t
     getKBUsedTransaction() override;
 
+    ReadPoolStats
+    getTransactionReadPoolStats() override;
+
     void
     closeLedgerDB() override;
 
@@ -237,6 +245,19 @@ private:
     {
         return txdb_->checkoutDb();
     }
+
+    /**
+     * @brief checkoutTransactionRead Checks out a session to the node store
+     *        transaction database that may only be used for reading. If a
+     *        read pool is configured, the session does not contend with
+     *        ledger writes.
+     * @return Session to the node store transaction database.
+     */
+    auto
+    checkoutTransactionRead()
+    {
+        return txdb_->checkoutReadDb();
+    }
 };
 
 bool
@@ -424,6 +445,21 @@ SQLiteDatabaseImp::saveValidatedLedger(
     return true;
 }
 
+bool
+SQLiteDatabaseImp::saveValidatedLedgers(
+    std::vector<std::shared_ptr<Ledger const>> const& ledgers,
+    bool current)
+{
+    if (existsLedger())
+    {
+        if (!detail::saveValidatedLedgers(
+                *lgrdb_, *txdb_, app_, ledgers, current))
+            return false;
+    }
+
+    return true;
+}
+
 std::optional<LedgerInfo>
 SQLiteDatabaseImp::getLedgerInfoByIndex(LedgerIndex ledgerSeq)
 {
@@ -554,7 +590,7 @@ SQLiteDatabaseImp::getTxHistory(LedgerIndex startIndex)
 
     if (existsTransaction())
     {
-        auto db = checkoutTransaction();
+        auto db = checkoutTransactionRead();
         auto const res = detail::getTxHistory(*db, app_, startIndex, 20).first;
 
         if (!res.empty())
@@ -574,7 +610,7 @@ SQLiteDatabaseImp::getOldestAccountTxs(AccountTxOptions const& options)
 
     if (existsTransaction())
     {
-        auto db = checkoutTransaction();
+        auto db = checkoutTransactionRead();
         return detail::getOldestAccountTxs(*db, app_, ledgerMaster, options, j_)
             .first;
     }
@@ -592,7 +628,7 @@ SQLiteDatabaseImp::getNewestAccountTxs(AccountTxOptions const& options)
 
     if (existsTransaction())
     {
-        auto db = checkoutTransaction();
+        auto db = checkoutTransactionRead();
         return detail::getNewestAccountTxs(*db, app_, ledgerMaster, options, j_)
             .first;
     }
@@ -608,7 +644,7 @@ SQLiteDatabaseImp::getOldestAccountTxsB(AccountTxOptions const& options)
 
     if (existsTransaction())
     {
-        auto db = checkoutTransaction();
+        auto db = checkoutTransactionRead();
         return detail::getOldestAccountTxsB(*db, app_, options, j_).first;
     }
 
@@ -623,7 +659,7 @@ SQLiteDatabaseImp::getNewestAccountTxsB(AccountTxOptions const& options)
 
     if (existsTransaction())
     {
-        auto db = checkoutTransaction();
+        auto db = checkoutTransactionRead();
         return detail::getNewestAccountTxsB(*db, app_, options, j_).first;
     }
 
@@ -653,7 +689,7 @@ SQLiteDatabaseImp::oldestAccountTxPage(AccountTxPageOptions const& options)
 
     if (existsTransaction())
     {
-        auto db = checkoutTransaction();
+        auto db = checkoutTransactionRead();
         auto newmarker =
             detail::oldestAccountTxPage(
                 *db, onUnsavedLedger, onTransaction, options, page_length)
@@ -687,7 +723,7 @@ SQLiteDatabaseImp::newestAccountTxPage(AccountTxPageOptions const& options)
 
     if (existsTransaction())
     {
-        auto db = checkoutTransaction();
+        auto db = checkoutTransactionRead();
         auto newmarker =
             detail::newestAccountTxPage(
                 *db, onUnsavedLedger, onTransaction, options, page_length)
@@ -720,7 +756,7 @@ SQLiteDatabaseImp::oldestAccountTxPageB(AccountTxPageOptions const& options)
 
     if (existsTransaction())
     {
-        auto db = checkoutTransaction();
+        auto db = checkoutTransactionRead();
         auto newmarker =
             detail::oldestAccountTxPage(
                 *db, onUnsavedLedger, onTransaction, options, page_length)
@@ -753,7 +789,7 @@ SQLiteDatabaseImp::newestAccountTxPageB(AccountTxPageOptions const& options)
 
     if (existsTransaction())
     {
-        auto db = checkoutTransaction();
+        auto db = checkoutTransactionRead();
         auto newmarker =
             detail::newestAccountTxPage(
                 *db, onUnsavedLedger, onTransaction, options, page_length)
@@ -775,7 +811,7 @@ SQLiteDatabaseImp::getTransaction(
 
     if (existsTransaction())
     {
-        auto db = checkoutTransaction();
+        auto db = checkoutTransactionRead();
         return detail::getTransaction(*db, app_, id, range, ec);
     }
 
@@ -845,6 +881,16 @@ SQLiteDatabaseImp::getKBUsedTransaction()
     return 0;
 }
 
+SQLiteDatabase::ReadPoolStats
+SQLiteDatabaseImp::getTransactionReadPoolStats()
+{
+    if (!existsTransaction())
+        return {};
+
+    auto const stats = txdb_->readStats();
+    return {stats.sessions, stats.checkouts, stats.waits};
+}
+
 void
 SQLiteDatabaseImp::closeLedgerDB()
 {
@@ -32,6 +32,7 @@ namespace ripple {
 
 class Application;
 class HashRouter;
+struct PreflightResult;
 
 /** Describes the pre-processing validity of a transaction.
 
@@ -127,6 +128,28 @@ apply(
     ApplyFlags flags,
     beast::Journal journal);
 
+/** Apply a transaction to an `OpenView`, continuing from its preflight.
+
+    This lets preflight, which needs no view, run before the caller
+    takes the lock protecting the view. If the view's rules differ from
+    those preflight ran under, preclaim runs preflight again.
+
+    @param app The current running `Application`.
+    @param view The open ledger that the transaction
+        will attempt to be applied to.
+    @param preflightResult The result of preflight for the transaction.
+
+    @see preflight, preclaim, doApply
+
+    @return A pair with the `TER` and a `bool` indicating
+            whether or not the transaction was applied.
+*/
+std::pair<TER, bool>
+apply(
+    Application& app,
+    OpenView& view,
+    PreflightResult const& preflightResult);
+
 /** Enum class for return value from `applyTransaction`
 
     @see applyTransaction
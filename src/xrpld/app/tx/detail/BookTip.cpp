@@ -79,4 +79,29 @@ BookTip::step(beast::Journal j)
     return true;
 }
 
+std::optional<Quality>
+bookTipQuality(ReadView const& view, Book const& book)
+{
+    uint256 key = getBookBase(book);
+    uint256 const end = getQualityNext(key);
+
+    for (;;)
+    {
+        auto const first_page = view.succ(key, end);
+
+        if (!first_page)
+            return std::nullopt;
+
+        unsigned int di = 0;
+        std::shared_ptr<SLE const> dir;
+        uint256 index;
+
+        if (cdirFirst(view, *first_page, dir, di, index))
+            return Quality(getQuality(*first_page));
+
+        // Skip an empty directory, as BookTip::step does.
+        key = *first_page;
+    }
+}
+
 }  // namespace ripple
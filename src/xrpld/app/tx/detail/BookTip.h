@@ -25,6 +25,7 @@
 #include <xrpl/protocol/Quality.h>
 
 #include <functional>
+#include <optional>
 
 namespace ripple {
 
@@ -82,6 +83,16 @@ public:
     step(beast::Journal j);
 };
 
+/** Returns the quality of the best offers in an order book.
+
+    This is the quality BookTip::step would present first, found without
+    peeking, and so copying, the directory or the offer.
+
+    @return The quality, or std::nullopt if the book has no offers.
+*/
+std::optional<Quality>
+bookTipQuality(ReadView const& view, Book const& book);
+
 }  // namespace ripple
 
 #endif
@@ -121,6 +121,19 @@ apply(
     return doApply(pcresult, app, view);
 }
 
+std::pair<TER, bool>
+apply(
+    Application& app,
+    OpenView& view,
+    PreflightResult const& preflightResult)
+{
+    STAmountSO stAmountSO{view.rules().enabled(fixSTAmountCanonicalize)};
+    NumberSO stNumberSO{view.rules().enabled(fixUniversalNumber)};
+
+    auto pcresult = preclaim(preflightResult, app, view);
+    return doApply(pcresult, app, view);
+}
+
 ApplyResult
 applyTransaction(
     Application& app,
@@ -25,16 +25,19 @@
 #include <xrpld/consensus/ConsensusTypes.h>
 #include <xrpld/consensus/DisputedTx.h>
 #include <xrpld/consensus/LedgerTiming.h>
+#include <xrpld/consensus/TxSetDiffCache.h>
 #include <xrpl/basics/Log.h>
 #include <xrpl/basics/chrono.h>
 #include <xrpl/beast/utility/Journal.h>
 #include <xrpl/json/json_writer.h>
 #include <boost/logic/tribool.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <deque>
 #include <optional>
 #include <sstream>
+#include <vector>
 
 namespace ripple {
 
@@ -536,6 +539,10 @@ private:
     void
     leaveConsensus();
 
+    // Complete the timing of the round, as it is accepted.
+    void
+    finishTiming();
+
     // The rounded or effective close time estimate from a proposer
     NetClock::time_point
     asCloseTime(NetClock::time_point raw) const;
@@ -581,6 +588,9 @@ private:
     // Transaction Sets, indexed by hash of transaction tree
     hash_map<typename TxSet_t::ID, const TxSet_t> acquired_;
 
+    // Differences between our position and the sets of our peers
+    TxSetDiffCache<TxSet_t> diffs_;
+
     std::optional<Result> result_;
     ConsensusCloseTimes rawCloseTimes_;
 
@@ -600,6 +610,21 @@ private:
     // nodes that have bowed out of this consensus process
     hash_set<NodeID_t> deadNodes_;
 
+    //-------------------------------------------------------------------------
+    // Timing of the current round
+
+    ConsensusRoundTiming roundTiming_;
+
+    // When we closed the ledger
+    typename clock_type::time_point closedAt_;
+
+    // When the initial proposal of each peer arrived
+    std::vector<typename clock_type::time_point> proposalArrivals_;
+
+    // Transaction sets we are waiting for, and since when
+    hash_map<typename TxSet_t::ID, typename clock_type::time_point>
+        txSetRequested_;
+
     // Journal for debugging
     beast::Journal const j_;
 };
@@ -680,9 +705,13 @@ Consensus<Adaptor>::startRoundInternal(
     openTime_.reset(clock_.now());
     currPeerPositions_.clear();
     acquired_.clear();
+    diffs_.clear();
     rawCloseTimes_.peers.clear();
     rawCloseTimes_.self = {};
     deadNodes_.clear();
+    roundTiming_ = {};
+    proposalArrivals_.clear();
+    txSetRequested_.clear();
 
     closeResolution_ = getNextLedgerTimeResolution(
         previousLedger_.closeTimeResolution(),
@@ -747,6 +776,9 @@ Consensus<Adaptor>::peerProposalInternal(
         return false;
     }
 
+    // Whether the peer proposed the same transactions as before, which
+    // it already voted on
+    bool sameTxns = false;
     {
         // update current position
         auto peerPosIt = currPeerPositions_.find(peerID);
@@ -776,17 +808,25 @@ Consensus<Adaptor>::peerProposalInternal(
         }
 
         if (peerPosIt != currPeerPositions_.end())
+        {
+            sameTxns = peerPosIt->second.proposal().position() ==
+                newPeerProp.position();
             peerPosIt->second = newPeerPos;
+        }
         else
+        {
             currPeerPositions_.emplace(peerID, newPeerPos);
+        }
     }
 
+    ++roundTiming_.proposals;
     if (newPeerProp.isInitial())
     {
         // Record the close time estimate
         JLOG(j_.trace()) << "Peer reports close time as "
                          << newPeerProp.closeTime().time_since_epoch().count();
         ++rawCloseTimes_.peers[newPeerProp.closeTime()];
+        proposalArrivals_.push_back(clock_.now());
     }
 
     JLOG(j_.trace()) << "Processing peer proposal " << newPeerProp.proposeSeq()
@@ -800,11 +840,17 @@ Consensus<Adaptor>::peerProposalInternal(
             // spawn a request for it and return nullopt/nullptr.  It will call
             // gotTxSet once it arrives
             if (auto set = adaptor_.acquireTxSet(newPeerProp.position()))
+            {
                 gotTxSet(now_, *set);
+            }
             else
+            {
                 JLOG(j_.debug()) << "Don't have tx set for peer";
+                txSetRequested_.emplace(
+                    newPeerProp.position(), clock_.now());
+            }
         }
-        else if (result_)
+        else if (result_ && !sameTxns)
         {
             updateDisputes(newPeerProp.nodeID(), ait->second);
         }
@@ -855,6 +901,16 @@ Consensus<Adaptor>::gotTxSet(
     if (!acquired_.emplace(id, txSet).second)
         return;
 
+    if (auto const it = txSetRequested_.find(id); it != txSetRequested_.end())
+    {
+        using namespace std::chrono;
+        ++roundTiming_.txSetsAcquired;
+        roundTiming_.txSetWait = std::max(
+            roundTiming_.txSetWait,
+            duration_cast<milliseconds>(clock_.now() - it->second));
+        txSetRequested_.erase(it);
+    }
+
     if (!result_)
     {
         JLOG(j_.debug()) << "Not creating disputes: no position yet.";
@@ -896,6 +952,7 @@ Consensus<Adaptor>::simulate(
     result_->proposers = prevProposers_ = currPeerPositions_.size();
     prevRoundTime_ = result_->roundTime.read();
     phase_ = ConsensusPhase::accepted;
+    finishTiming();
     adaptor_.onForceAccept(
         *result_,
         previousLedger_,
@@ -998,6 +1055,8 @@ Consensus<Adaptor>::getJson(bool full) const
             }
             ret["dead_nodes"] = std::move(dnj);
         }
+
+        ret["tx_set_diffs"] = diffs_.getJson();
     }
 
     return ret;
@@ -1024,6 +1083,7 @@ Consensus<Adaptor>::handleWrongLedger(typename Ledger_t::ID const& lgrId)
             result_->disputes.clear();
             result_->compares.clear();
         }
+        diffs_.clear();
 
         currPeerPositions_.clear();
         rawCloseTimes_.peers.clear();
@@ -1295,6 +1355,7 @@ Consensus<Adaptor>::phaseEstablish()
     prevRoundTime_ = result_->roundTime.read();
     phase_ = ConsensusPhase::accepted;
     JLOG(j_.debug()) << "transitioned to ConsensusPhase::accepted";
+    finishTiming();
     adaptor_.onAccept(
         *result_,
         previousLedger_,
@@ -1314,6 +1375,9 @@ Consensus<Adaptor>::closeLedger()
     phase_ = ConsensusPhase::establish;
     JLOG(j_.debug()) << "transitioned to ConsensusPhase::establish";
     rawCloseTimes_.self = now_;
+    closedAt_ = clock_.now();
+    openTime_.tick(closedAt_);
+    roundTiming_.open = openTime_.read();
 
     result_.emplace(adaptor_.onClose(previousLedger_, now_, mode_.get()));
     result_->roundTime.reset(clock_.now());
@@ -1397,8 +1461,13 @@ Consensus<Adaptor>::updateOurPositions()
     // This will stay unseated unless there are any changes
     std::optional<TxSet_t> ourNewSet;
 
+    // The transactions we changed our vote on, and whether they were in
+    // our old set
+    typename TxSetDiffCache<TxSet_t>::Diff changed;
+
     // Update votes on disputed transactions
     {
+        auto const start = clock_.now();
         std::optional<typename TxSet_t::MutableTxSet> mutableSet;
         for (auto& [txId, dispute] : result_->disputes)
         {
@@ -1411,6 +1480,7 @@ Consensus<Adaptor>::updateOurPositions()
             {
                 if (!mutableSet)
                     mutableSet.emplace(result_->txns);
+                changed[txId] = !dispute.getOurVote();
 
                 if (dispute.getOurVote())
                 {
@@ -1427,6 +1497,9 @@ Consensus<Adaptor>::updateOurPositions()
 
         if (mutableSet)
             ourNewSet.emplace(std::move(*mutableSet));
+        roundTiming_.disputeTime +=
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                clock_.now() - start);
     }
 
     NetClock::time_point consensusCloseTime = {};
@@ -1511,6 +1584,7 @@ Consensus<Adaptor>::updateOurPositions()
     {
         auto newID = ourNewSet->id();
 
+        diffs_.rebase(result_->txns.id(), newID, changed);
         result_->txns = std::move(*ourNewSet);
 
         JLOG(j_.info()) << "Position change: CTime "
@@ -1634,11 +1708,18 @@ Consensus<Adaptor>::createDisputes(TxSet_t const& o)
     JLOG(j_.debug()) << "createDisputes " << result_->txns.id() << " to "
                      << o.id();
 
-    auto differences = result_->txns.compare(o);
+    auto const start = clock_.now();
+
+    // Sets too far apart are compared again, listing as many differences
+    // as the comparison allows
+    std::optional<typename TxSetDiffCache<TxSet_t>::Diff> listed;
+    auto differences = diffs_.diff(result_->txns, o);
+    if (!differences)
+        differences = &listed.emplace(result_->txns.compare(o));
 
     int dc = 0;
 
-    for (auto const& [txId, inThisSet] : differences)
+    for (auto const& [txId, inThisSet] : *differences)
     {
         ++dc;
         // create disputed transactions (from the ledger that has them)
@@ -1673,6 +1754,9 @@ Consensus<Adaptor>::createDisputes(TxSet_t const& o)
         result_->disputes.emplace(txID, std::move(dtx));
     }
     JLOG(j_.debug()) << dc << " differences found";
+    roundTiming_.disputeTime +=
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            clock_.now() - start);
 }
 
 template <class Adaptor>
@@ -1687,11 +1771,64 @@ Consensus<Adaptor>::updateDisputes(NodeID_t const& node, TxSet_t const& other)
     if (result_->compares.find(other.id()) == result_->compares.end())
         createDisputes(other);
 
-    for (auto& it : result_->disputes)
+    // The peer has the transactions we disagree on, and those we agree
+    // on and have ourselves. If the sets differ by too much to list, ask
+    // the peer's set.
+    auto const start = clock_.now();
+    auto const differences = diffs_.diff(result_->txns, other);
+    for (auto& [txId, d] : result_->disputes)
+    {
+        if (!differences)
+        {
+            d.setVote(node, other.exists(txId));
+            continue;
+        }
+        auto const it = differences->find(txId);
+        d.setVote(
+            node, it != differences->end() ? !it->second : d.getOurVote());
+    }
+    roundTiming_.disputeTime +=
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            clock_.now() - start);
+}
+
+template <class Adaptor>
+void
+Consensus<Adaptor>::finishTiming()
+{
+    using namespace std::chrono;
+    assert(result_);
+
+    auto& timing = roundTiming_;
+    timing.establish = result_->roundTime.read();
+    timing.proposers = currPeerPositions_.size();
+    timing.disputes = result_->disputes.size();
+    timing.closeTimeAgreed = haveCloseTimeConsensus_;
+
+    // The spread of the close times proposed, ours included
+    if (!rawCloseTimes_.peers.empty())
     {
-        auto& d = it.second;
-        d.setVote(node, other.exists(d.tx().id()));
+        auto const low =
+            std::min(rawCloseTimes_.peers.begin()->first, rawCloseTimes_.self);
+        auto const high = std::max(
+            rawCloseTimes_.peers.rbegin()->first, rawCloseTimes_.self);
+        timing.closeTimeSpread = high - low;
     }
+
+    // When the initial proposals arrived, relative to our close
+    if (!proposalArrivals_.empty())
+    {
+        std::sort(proposalArrivals_.begin(), proposalArrivals_.end());
+        auto const offset = [this](auto const& arrival) {
+            return duration_cast<milliseconds>(arrival - closedAt_);
+        };
+        timing.firstProposal = offset(proposalArrivals_.front());
+        timing.medianProposal =
+            offset(proposalArrivals_[proposalArrivals_.size() / 2]);
+        timing.lastProposal = offset(proposalArrivals_.back());
+    }
+
+    result_->timing = timing;
 }
 
 template <class Adaptor>
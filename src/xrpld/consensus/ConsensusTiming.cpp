@@ -0,0 +1,154 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpld/consensus/ConsensusTiming.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace ripple {
+
+Json::Value
+ConsensusRoundTiming::getJson() const
+{
+    using Int = Json::Value::Int;
+
+    Json::Value ret(Json::objectValue);
+    ret["ledger_seq"] = seq;
+    ret["open_ms"] = static_cast<Int>(open.count());
+    ret["establish_ms"] = static_cast<Int>(establish.count());
+    ret["proposers"] = static_cast<Int>(proposers);
+    ret["proposals"] = static_cast<Int>(proposals);
+    ret["first_proposal_ms"] = static_cast<Int>(firstProposal.count());
+    ret["median_proposal_ms"] = static_cast<Int>(medianProposal.count());
+    ret["last_proposal_ms"] = static_cast<Int>(lastProposal.count());
+    ret["disputes"] = static_cast<Int>(disputes);
+    ret["dispute_us"] = static_cast<Int>(disputeTime.count());
+    ret["tx_sets_acquired"] = static_cast<Int>(txSetsAcquired);
+    ret["tx_set_wait_ms"] = static_cast<Int>(txSetWait.count());
+    ret["close_time_agreed"] = closeTimeAgreed;
+    ret["close_time_spread"] = static_cast<Int>(closeTimeSpread.count());
+    ret["build_ms"] = static_cast<Int>(build.count());
+    ret["accept_ms"] = static_cast<Int>(accept.count());
+    return ret;
+}
+
+ConsensusTimingHistory::ConsensusTimingHistory(std::size_t rounds)
+    : rounds_(std::max<std::size_t>(rounds, 1))
+{
+}
+
+void
+ConsensusTimingHistory::add(ConsensusRoundTiming const& timing)
+{
+    std::lock_guard lock(mutex_);
+    rounds_.push_back(timing);
+}
+
+std::size_t
+ConsensusTimingHistory::size() const
+{
+    std::lock_guard lock(mutex_);
+    return rounds_.size();
+}
+
+std::optional<ConsensusRoundTiming>
+ConsensusTimingHistory::last() const
+{
+    std::lock_guard lock(mutex_);
+    if (rounds_.empty())
+        return std::nullopt;
+    return rounds_.back();
+}
+
+Json::Value
+ConsensusTimingHistory::getJson(std::size_t recent) const
+{
+    using Int = Json::Value::Int;
+
+    std::vector<ConsensusRoundTiming> rounds;
+    {
+        std::lock_guard lock(mutex_);
+        rounds.assign(rounds_.begin(), rounds_.end());
+    }
+
+    Json::Value ret(Json::objectValue);
+    ret["rounds"] = static_cast<Int>(rounds.size());
+    if (rounds.empty())
+        return ret;
+
+    // The nearest rank percentiles of one measure over the rounds
+    std::vector<std::int64_t> values;
+    values.reserve(rounds.size());
+    auto const percentiles = [&rounds, &values](auto const& measure) {
+        values.clear();
+        for (auto const& round : rounds)
+            values.push_back(static_cast<std::int64_t>(measure(round)));
+        std::sort(values.begin(), values.end());
+
+        auto const rank = [&values](std::size_t percent) {
+            auto const n = (values.size() * percent + 99) / 100;
+            return static_cast<Int>(values[std::max<std::size_t>(n, 1) - 1]);
+        };
+        Json::Value p(Json::objectValue);
+        p["p50"] = rank(50);
+        p["p90"] = rank(90);
+        p["p99"] = rank(99);
+        p["max"] = static_cast<Int>(values.back());
+        return p;
+    };
+
+    Json::Value& stats = (ret["percentiles"] = Json::objectValue);
+    stats["open_ms"] =
+        percentiles([](auto const& r) { return r.open.count(); });
+    stats["establish_ms"] =
+        percentiles([](auto const& r) { return r.establish.count(); });
+    stats["proposers"] = percentiles([](auto const& r) { return r.proposers; });
+    stats["first_proposal_ms"] =
+        percentiles([](auto const& r) { return r.firstProposal.count(); });
+    stats["median_proposal_ms"] =
+        percentiles([](auto const& r) { return r.medianProposal.count(); });
+    stats["last_proposal_ms"] =
+        percentiles([](auto const& r) { return r.lastProposal.count(); });
+    stats["disputes"] = percentiles([](auto const& r) { return r.disputes; });
+    stats["dispute_us"] =
+        percentiles([](auto const& r) { return r.disputeTime.count(); });
+    stats["tx_set_wait_ms"] =
+        percentiles([](auto const& r) { return r.txSetWait.count(); });
+    stats["close_time_spread"] =
+        percentiles([](auto const& r) { return r.closeTimeSpread.count(); });
+    stats["build_ms"] =
+        percentiles([](auto const& r) { return r.build.count(); });
+    stats["accept_ms"] =
+        percentiles([](auto const& r) { return r.accept.count(); });
+
+    ret["close_time_agreed"] = static_cast<Int>(std::count_if(
+        rounds.begin(), rounds.end(), [](auto const& r) {
+            return r.closeTimeAgreed;
+        }));
+
+    Json::Value& last = (ret["recent"] = Json::arrayValue);
+    auto const n = std::min(recent, rounds.size());
+    for (auto it = rounds.rbegin(); it != rounds.rbegin() + n; ++it)
+        last.append(it->getJson());
+
+    return ret;
+}
+
+}  // namespace ripple
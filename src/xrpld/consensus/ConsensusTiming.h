@@ -0,0 +1,125 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_CONSENSUS_CONSENSUS_TIMING_H_INCLUDED
+#define RIPPLE_CONSENSUS_CONSENSUS_TIMING_H_INCLUDED
+
+#include <xrpl/basics/chrono.h>
+#include <xrpl/json/json_value.h>
+
+#include <boost/circular_buffer.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+namespace ripple {
+
+/** Where the time of one consensus round went.
+
+    Consensus fills in the phases of the round as it progresses. The
+    application fills in the time taken to build and accept the ledger.
+
+    Proposal arrival times are offsets from the moment this node closed its
+    ledger, negative for proposals which arrived before it did.
+*/
+struct ConsensusRoundTiming
+{
+    using milliseconds = std::chrono::milliseconds;
+
+    //! Sequence of the ledger built in the round, 0 if not known
+    std::uint32_t seq = 0;
+
+    //! How long the ledger was open, and how long establishing took
+    milliseconds open{0};
+    milliseconds establish{0};
+
+    //! Peers proposing at the end of the round, and proposals received
+    std::size_t proposers = 0;
+    std::size_t proposals = 0;
+
+    //! Arrival of the first proposal from each peer
+    milliseconds firstProposal{0};
+    milliseconds medianProposal{0};
+    milliseconds lastProposal{0};
+
+    //! Transactions disputed, and the time spent creating and updating
+    //! the disputes
+    std::size_t disputes = 0;
+    std::chrono::microseconds disputeTime{0};
+
+    //! Transaction sets acquired from peers, and the longest wait for one
+    std::size_t txSetsAcquired = 0;
+    milliseconds txSetWait{0};
+
+    //! Whether the close time was agreed on, and the spread between the
+    //! earliest and the latest close time proposed by the peers
+    bool closeTimeAgreed = false;
+    NetClock::duration closeTimeSpread{0};
+
+    //! Building the ledger, and all of accepting it including the build
+    milliseconds build{0};
+    milliseconds accept{0};
+
+    Json::Value
+    getJson() const;
+};
+
+/** The timing of the most recent consensus rounds.
+
+    Reports percentiles of each measure over the rounds kept, so that
+    changes to the consensus parameters can be judged by their effect on
+    the round times.
+*/
+class ConsensusTimingHistory
+{
+public:
+    //! Number of rounds kept by default
+    static constexpr std::size_t defaultRounds = 256;
+
+    explicit ConsensusTimingHistory(std::size_t rounds = defaultRounds);
+
+    /** Record a round, dropping the oldest if full. */
+    void
+    add(ConsensusRoundTiming const& timing);
+
+    /** The number of rounds kept. */
+    std::size_t
+    size() const;
+
+    /** The most recent round, if any. */
+    std::optional<ConsensusRoundTiming>
+    last() const;
+
+    /** Percentiles over the rounds kept, and the most recent rounds.
+
+        @param recent The number of most recent rounds to list.
+    */
+    Json::Value
+    getJson(std::size_t recent) const;
+
+private:
+    mutable std::mutex mutex_;
+    boost::circular_buffer<ConsensusRoundTiming> rounds_;
+};
+
+}  // namespace ripple
+
+#endif
@@ -21,6 +21,7 @@
 #define RIPPLE_CONSENSUS_CONSENSUS_TYPES_H_INCLUDED
 
 #include <xrpld/consensus/ConsensusProposal.h>
+#include <xrpld/consensus/ConsensusTiming.h>
 #include <xrpld/consensus/DisputedTx.h>
 #include <xrpl/basics/chrono.h>
 #include <chrono>
@@ -238,6 +239,9 @@ struct ConsensusResult
 
     // The number of peers proposing during the round
     std::size_t proposers = 0;
+
+    // Where the time of the round went
+    ConsensusRoundTiming timing;
 };
 }  // namespace ripple
 
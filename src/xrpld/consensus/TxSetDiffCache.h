@@ -0,0 +1,178 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_CONSENSUS_TXSETDIFFCACHE_H_INCLUDED
+#define RIPPLE_CONSENSUS_TXSETDIFFCACHE_H_INCLUDED
+
+#include <xrpl/basics/UnorderedContainers.h>
+#include <xrpl/json/json_value.h>
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <utility>
+
+namespace ripple {
+
+/** Differences between transaction sets, computed once per pair of sets.
+
+    Consensus compares our position with the position of every peer, and
+    decides each peer's vote on every disputed transaction from the
+    differences. Many peers propose the same set, and peers propose again
+    without changing their set, so the differences are cached by the pair
+    of set IDs.
+
+    When our position changes, it changes by the disputed transactions we
+    changed our vote on. The cached differences against our old position
+    are rebased onto the new one using that change, rather than comparing
+    the new position with every peer's set again.
+
+    Sets may differ by more transactions than a comparison lists. Such
+    differences are neither kept nor rebased: only the fact that they are
+    incomplete is cached, and callers must look in the sets themselves.
+
+    The cache is meant to be cleared every round.
+
+    @tparam TxSet_t The transaction set type. Must provide `id()` and
+                    `compare(TxSet_t const&, bool& complete)`.
+*/
+template <class TxSet_t>
+class TxSetDiffCache
+{
+public:
+    using ID = typename TxSet_t::ID;
+    using TxID = typename TxSet_t::Tx::ID;
+
+    /** The transactions in one set but not the other.
+
+        The value is true if the transaction is in the first set.
+    */
+    using Diff = std::map<TxID, bool>;
+
+    /** The differences between two sets.
+
+        @return The cached differences, computed if not cached yet, or
+                null if the sets differ by too many transactions to list.
+                The pointer is valid until the next call to `rebase` or
+                `clear`.
+    */
+    Diff const*
+    diff(TxSet_t const& ours, TxSet_t const& other)
+    {
+        auto const [it, inserted] =
+            diffs_.try_emplace(std::make_pair(ours.id(), other.id()));
+        if (!inserted)
+        {
+            ++hits_;
+        }
+        else if (ours.id() == other.id())
+        {
+            it->second.emplace();
+        }
+        else
+        {
+            ++compares_;
+            bool complete = false;
+            auto diff = ours.compare(other, complete);
+            if (complete)
+                it->second = std::move(diff);
+            else
+                ++incomplete_;
+        }
+        return it->second ? &*it->second : nullptr;
+    }
+
+    /** Our set changed, by the given differences.
+
+        The differences against `from` are replaced by the differences
+        against `to`. Any other differences, and those which are not
+        complete, are dropped.
+
+        @param from Our old set.
+        @param to Our new set.
+        @param change The differences between the old and the new set.
+    */
+    void
+    rebase(ID const& from, ID const& to, Diff const& change)
+    {
+        if (from == to)
+            return;
+
+        hash_map<std::pair<ID, ID>, std::optional<Diff>> rebased;
+        for (auto& [key, diff] : diffs_)
+        {
+            if (key.first != from || !diff)
+                continue;
+
+            // A transaction in both differences is in both `to` and the
+            // other set. One only in the change differs from the other set
+            // the way it differs from `from`.
+            for (auto const& [txId, inFrom] : change)
+            {
+                auto const it = diff->find(txId);
+                if (it != diff->end())
+                    diff->erase(it);
+                else
+                    diff->emplace(txId, !inFrom);
+            }
+            rebased.emplace(std::make_pair(to, key.second), std::move(diff));
+            ++rebased_;
+        }
+        diffs_ = std::move(rebased);
+    }
+
+    /** Forget all the differences. */
+    void
+    clear()
+    {
+        diffs_.clear();
+    }
+
+    /** The number of pairs of sets cached. */
+    std::size_t
+    size() const
+    {
+        return diffs_.size();
+    }
+
+    /** Counts of lookups, comparisons and rebased or incomplete diffs. */
+    Json::Value
+    getJson() const
+    {
+        Json::Value ret(Json::objectValue);
+        ret["hits"] = static_cast<Json::UInt>(hits_);
+        ret["compares"] = static_cast<Json::UInt>(compares_);
+        ret["rebased"] = static_cast<Json::UInt>(rebased_);
+        ret["incomplete"] = static_cast<Json::UInt>(incomplete_);
+        return ret;
+    }
+
+private:
+    // Unseated if the differences are not complete
+    hash_map<std::pair<ID, ID>, std::optional<Diff>> diffs_;
+
+    std::uint64_t hits_ = 0;
+    std::uint64_t compares_ = 0;
+    std::uint64_t rebased_ = 0;
+    std::uint64_t incomplete_ = 0;
+};
+
+}  // namespace ripple
+
+#endif
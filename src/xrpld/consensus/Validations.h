@@ -344,6 +344,17 @@ class Validations
     // Set of ledgers being acquired from the network
     hash_map<std::pair<Seq, ID>, hash_set<NodeID>> acquiring_;
 
+    // Ledgers available locally, with the trusted nodes whose latest
+    // validation is for them, not yet reflected in the trie. Many nodes
+    // validate the same ledger, so the trie is updated once per ledger just
+    // before it is read, instead of once per validation as they arrive.
+    struct PendingLedger
+    {
+        Ledger ledger;
+        hash_set<NodeID> nodes;
+    };
+    hash_map<std::pair<Seq, ID>, PendingLedger> pending_;
+
     // Parameters to determine validation staleness
     ValidationParms const parms_;
 
@@ -359,6 +370,17 @@ private:
         NodeID const& nodeID,
         Validation const& val)
     {
+        // A pending ledger stands in for the node's ledger in the trie
+        bool wasPending = false;
+        {
+            auto it = pending_.find(std::make_pair(val.seq(), val.ledgerID()));
+            if (it != pending_.end())
+            {
+                wasPending = it->second.nodes.erase(nodeID) != 0;
+                if (it->second.nodes.empty())
+                    pending_.erase(it);
+            }
+        }
         {
             auto it =
                 acquiring_.find(std::make_pair(val.seq(), val.ledgerID()));
@@ -371,7 +393,8 @@ private:
         }
         {
             auto it = lastLedger_.find(nodeID);
-            if (it != lastLedger_.end() && it->second.id() == val.ledgerID())
+            if (it != lastLedger_.end() &&
+                (wasPending || it->second.id() == val.ledgerID()))
             {
                 trie_.remove(it->second);
                 lastLedger_.erase(nodeID);
@@ -414,12 +437,28 @@ private:
         trie_.insert(ledger);
     }
 
+    // Reflect the validations of ledgers available locally in the trie
+    void
+    applyPending(std::lock_guard<Mutex> const& lock)
+    {
+        for (auto const& [_, pending] : pending_)
+        {
+            (void)_;
+            for (NodeID const& nodeID : pending.nodes)
+                updateTrie(lock, nodeID, pending.ledger);
+        }
+        pending_.clear();
+    }
+
     /** Process a new validation
 
         Process a new trusted validation from a validator. This will be
         reflected only after the validated ledger is successfully acquired by
-        the local node. In the interim, the prior validated ledger from this
-        node remains.
+        the local node, and the trie is next read. In the interim, the prior
+        validated ledger from this node remains.
+
+        The ledger is looked up once, by the first validation for it. The
+        validations which follow only join the set of nodes waiting for it.
 
         @param lock Existing lock of mutex_
         @param nodeID The node identifier of the validating node
@@ -436,39 +475,57 @@ private:
     {
         assert(val.trusted());
 
-        // Clear any prior acquiring ledger for this node
+        // Clear any prior acquiring or pending ledger for this node
+        std::optional<Ledger> priorLedger;
         if (prior)
         {
-            auto it = acquiring_.find(*prior);
-            if (it != acquiring_.end())
+            if (auto it = acquiring_.find(*prior); it != acquiring_.end())
             {
                 it->second.erase(nodeID);
                 if (it->second.empty())
                     acquiring_.erase(it);
             }
+            if (auto it = pending_.find(*prior); it != pending_.end())
+            {
+                if (it->second.nodes.erase(nodeID))
+                    priorLedger = it->second.ledger;
+                if (it->second.nodes.empty())
+                    pending_.erase(it);
+            }
         }
 
-        checkAcquired(lock);
+        // While the new ledger is acquired, the prior one remains, even if
+        // it was still pending
+        auto acquiring = [&](std::pair<Seq, ID> const& valPair) {
+            if (priorLedger)
+                updateTrie(lock, nodeID, *priorLedger);
+            acquiring_[valPair].insert(nodeID);
+        };
 
         std::pair<Seq, ID> valPair{val.seq(), val.ledgerID()};
-        auto it = acquiring_.find(valPair);
-        if (it != acquiring_.end())
+        if (acquiring_.count(valPair))
+        {
+            acquiring(valPair);
+        }
+        else if (auto it = pending_.find(valPair); it != pending_.end())
         {
-            it->second.insert(nodeID);
+            it->second.nodes.insert(nodeID);
         }
         else
         {
             if (std::optional<Ledger> ledger = adaptor_.acquire(val.ledgerID()))
-                updateTrie(lock, nodeID, *ledger);
+                pending_.emplace(
+                    valPair, PendingLedger{std::move(*ledger), {nodeID}});
             else
-                acquiring_[valPair].insert(nodeID);
+                acquiring(valPair);
         }
     }
 
     /** Use the trie for a calculation
 
-        Accessing the trie through this helper ensures acquiring validations
-        are checked and any stale validations are flushed from the trie.
+        Accessing the trie through this helper ensures pending and acquiring
+        validations are checked and any stale validations are flushed from the
+        trie.
 
         @param lock Existing lock of mutex_
         @param f Invokable with signature (LedgerTrie<Ledger> &)
@@ -484,6 +541,7 @@ private:
         // Call current to flush any stale validations
         current(
             lock, [](auto) {}, [](auto, auto) {});
+        applyPending(lock);
         checkAcquired(lock);
         return f(trie_);
     }
@@ -825,9 +883,10 @@ public:
     }
 
     Json::Value
-    getJsonTrie() const
+    getJsonTrie()
     {
         std::lock_guard lock{mutex_};
+        applyPending(lock);
         return trie_.getJson();
     }
 
@@ -979,6 +1038,7 @@ public:
             });
 
         // Count parent ledgers as fallback
+        applyPending(lock);
         return std::count_if(
             lastLedger_.begin(),
             lastLedger_.end(),
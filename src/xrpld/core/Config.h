@@ -204,6 +204,15 @@ public:
     int PATH_SEARCH_FAST = 2;
     int PATH_SEARCH_MAX = 3;
 
+    // The most JobQueue threads used to measure the liquidity of candidate
+    // paths found by one path search. 1 measures them on the searching
+    // thread.
+    int PATH_RANK_THREADS = 4;
+
+    // The most threads used to update path_find subscriptions when a new
+    // ledger is accepted.
+    int PATH_UPDATE_THREADS = 2;
+
     // Validation
     std::optional<std::size_t>
         VALIDATION_QUORUM;  // validations to consider ledger authoritative
@@ -226,8 +235,13 @@ public:
     // Compression
     bool COMPRESSION = false;
 
-    // Enable the experimental Ledger Replay functionality
-    bool LEDGER_REPLAY = false;
+    // Catch up by replaying ledger deltas instead of acquiring full ledgers
+    bool LEDGER_REPLAY = true;
+
+    // History backfill: the most ledgers acquired at once (0 = choose for
+    // me), and the node store write load above which it pauses.
+    std::size_t BACKFILL_PARALLEL = 0;
+    int BACKFILL_MAX_WRITE_LOAD = 8192;
 
     // Work queue limits
     int MAX_TRANSACTIONS = 250;
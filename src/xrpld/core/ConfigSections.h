@@ -39,6 +39,11 @@ struct ConfigSection
     {
         return "import_db";
     }
+    static std::string
+    coldNodeDatabase()
+    {
+        return "node_db_cold";
+    }
 };
 
 // VFALCO TODO Rename and replace these macros with variables.
@@ -51,6 +56,7 @@ struct ConfigSection
 #define SECTION_ELB_SUPPORT "elb_support"
 #define SECTION_FEE_DEFAULT "fee_default"
 #define SECTION_FETCH_DEPTH "fetch_depth"
+#define SECTION_HISTORY_BACKFILL "history_backfill"
 #define SECTION_INSIGHT "insight"
 #define SECTION_IO_WORKERS "io_workers"
 #define SECTION_IPS "ips"
@@ -67,6 +73,8 @@ struct ConfigSection
 #define SECTION_PATH_SEARCH "path_search"
 #define SECTION_PATH_SEARCH_FAST "path_search_fast"
 #define SECTION_PATH_SEARCH_MAX "path_search_max"
+#define SECTION_PATH_RANK_THREADS "path_rank_threads"
+#define SECTION_PATH_UPDATE_THREADS "path_update_threads"
 #define SECTION_PEER_PRIVATE "peer_private"
 #define SECTION_PEERS_MAX "peers_max"
 #define SECTION_PEERS_IN_MAX "peers_in_max"
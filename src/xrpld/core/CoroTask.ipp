@@ -0,0 +1,243 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_CORE_COROTASKINL_H_INCLUDED
+#define RIPPLE_CORE_COROTASKINL_H_INCLUDED
+
+#include <cassert>
+#include <exception>
+#include <utility>
+
+namespace ripple {
+
+struct JobQueue::CoroTask::promise_type
+{
+    detail::LocalValues lvs;
+
+    // Where to leave an exception escaping the task. Set by resumeCoroTask
+    // each time the task is resumed, since it may run on another thread.
+    std::exception_ptr* error = nullptr;
+
+    // The frame destroys itself when the coroutine function returns, so
+    // nothing may touch the handle after the resume which completes it.
+    struct FinalAwaiter
+    {
+        bool
+        await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void
+        await_suspend(handle_type h) const noexcept
+        {
+            h.destroy();
+        }
+
+        void
+        await_resume() const noexcept
+        {
+        }
+    };
+
+    CoroTask
+    get_return_object() noexcept
+    {
+        return CoroTask{handle_type::from_promise(*this)};
+    }
+
+    std::suspend_always
+    initial_suspend() const noexcept
+    {
+        return {};
+    }
+
+    FinalAwaiter
+    final_suspend() const noexcept
+    {
+        return {};
+    }
+
+    void
+    return_void() const noexcept
+    {
+    }
+
+    // An exception escaping the task is kept until the frame has been
+    // destroyed at the final suspend point. resumeCoroTask then rethrows it
+    // out of the job running the task, as it would be for any other job.
+    void
+    unhandled_exception() const noexcept
+    {
+        assert(error);
+        *error = std::current_exception();
+    }
+};
+
+/** Continues a suspended CoroTask in a new job.
+
+    A Resumer may be copied, for example into a std::function, but exactly
+    one copy must be invoked, exactly once. If the JobQueue refuses the job
+    because it is stopping, the task runs to completion on the invoking
+    thread instead, so that shutdown does not wait on it forever.
+*/
+class JobQueue::CoroTask::Resumer
+{
+private:
+    JobQueue* jq_;
+    handle_type handle_;
+    JobType type_;
+    std::string name_;
+
+public:
+    // Private: Used in the implementation
+    Resumer(JobQueue& jq, handle_type h, JobType type, std::string name)
+        : jq_(&jq), handle_(h), type_(type), name_(std::move(name))
+    {
+    }
+
+    void
+    operator()() const
+    {
+        assert(handle_);
+        auto const jq = jq_;
+        auto const h = handle_;
+        if (!jq->addJob(type_, name_, [jq, h]() { jq->resumeCoroTask(h); }))
+            jq->resumeCoroTask(h);
+    }
+};
+
+template <class F>
+class JobQueue::CoroTask::Awaiter
+{
+private:
+    JobQueue& jq_;
+    JobType type_;
+    std::string name_;
+    F f_;
+
+public:
+    // Private: Used in the implementation
+    Awaiter(JobQueue& jq, JobType type, std::string name, F f)
+        : jq_(jq), type_(type), name_(std::move(name)), f_(std::move(f))
+    {
+    }
+
+    bool
+    await_ready() const noexcept
+    {
+        return false;
+    }
+
+    void
+    await_suspend(handle_type h)
+    {
+        {
+            std::lock_guard lock(jq_.m_mutex);
+            ++jq_.nSuspend_;
+        }
+
+        // This awaiter lives in the frame of the suspended task. The task
+        // may be resumed, and its frame destroyed, on another thread before
+        // f returns, so move everything out of the frame first.
+        auto f = std::move(f_);
+        f(Resumer{jq_, h, type_, std::move(name_)});
+    }
+
+    void
+    await_resume() const noexcept
+    {
+    }
+};
+
+inline JobQueue::CoroTask::CoroTask(handle_type h) noexcept : handle_(h)
+{
+}
+
+inline JobQueue::CoroTask::CoroTask(CoroTask&& other) noexcept
+    : handle_(std::exchange(other.handle_, {}))
+{
+}
+
+inline JobQueue::CoroTask::~CoroTask()
+{
+    if (handle_)
+        handle_.destroy();
+}
+
+inline JobQueue::CoroTask::handle_type
+JobQueue::CoroTask::release() noexcept
+{
+    return std::exchange(handle_, {});
+}
+
+inline bool
+JobQueue::postCoroTask(JobType t, std::string const& name, CoroTask task)
+{
+    // Until its first job runs, the task counts as suspended.
+    {
+        std::lock_guard lock(m_mutex);
+        ++nSuspend_;
+    }
+
+    auto const h = task.release();
+    if (addJob(t, name, [this, h]() { resumeCoroTask(h); }))
+        return true;
+
+    // The task will not run.
+    {
+        std::lock_guard lock(m_mutex);
+        --nSuspend_;
+    }
+    h.destroy();
+    return false;
+}
+
+template <class F>
+JobQueue::CoroTask::Awaiter<std::decay_t<F>>
+JobQueue::suspendCoroTask(JobType t, std::string const& name, F&& f)
+{
+    return CoroTask::Awaiter<std::decay_t<F>>(
+        *this, t, name, std::forward<F>(f));
+}
+
+inline void
+JobQueue::resumeCoroTask(CoroTask::handle_type h)
+{
+    {
+        std::lock_guard lock(m_mutex);
+        --nSuspend_;
+    }
+    std::exception_ptr error;
+    h.promise().error = &error;
+    auto saved = detail::getLocalValues().release();
+    detail::getLocalValues().reset(&h.promise().lvs);
+    // Once resumed, the task may complete and destroy its frame, or suspend
+    // and be resumed elsewhere. Either way, h must not be used again here.
+    h.resume();
+    detail::getLocalValues().release();
+    detail::getLocalValues().reset(saved);
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+}  // namespace ripple
+
+#endif
@@ -24,9 +24,11 @@
 #include <xrpld/core/Config.h>
 #include <xrpld/core/SociDB.h>
 #include <boost/filesystem/path.hpp>
+#include <atomic>
 #include <mutex>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace soci {
 class session;
@@ -48,6 +50,12 @@ public:
         : session_(std::move(it)), lock_(m)
     {
     }
+    LockedSociSession(
+        std::shared_ptr<soci::session> it,
+        std::unique_lock<mutex>&& lock)
+        : session_(std::move(it)), lock_(std::move(lock))
+    {
+    }
     LockedSociSession(LockedSociSession&& rhs) noexcept
         : session_(std::move(rhs.session_)), lock_(std::move(rhs.lock_))
     {
@@ -91,6 +99,9 @@ public:
         // Indicates whether or not to return the `globalPragma`
         // from commonPragma()
         bool useGlobalPragma = false;
+        // Number of read-only sessions to open against the transaction
+        // database. Other databases never open a read pool.
+        std::size_t readConnections = 0;
 
         std::vector<std::string> const*
         commonPragma() const
@@ -109,12 +120,33 @@ public:
         Logs* logs;
     };
 
+    /** Usage counters for the pool of read-only sessions. */
+    struct ReadStats
+    {
+        std::size_t sessions = 0;
+        std::uint64_t checkouts = 0;
+        std::uint64_t waits = 0;
+    };
+
     template <std::size_t N, std::size_t M>
     DatabaseCon(
         Setup const& setup,
         std::string const& dbName,
         std::array<char const*, N> const& pragma,
         std::array<char const*, M> const& initSQL)
+        : DatabaseCon(setup, dbName, pragma, initSQL, std::size_t{0})
+    {
+    }
+
+    // Use this constructor to open a pool of `readConnections` read-only
+    // sessions next to the main session
+    template <std::size_t N, std::size_t M>
+    DatabaseCon(
+        Setup const& setup,
+        std::string const& dbName,
+        std::array<char const*, N> const& pragma,
+        std::array<char const*, M> const& initSQL,
+        std::size_t readConnections)
         // Use temporary files or regular DB files?
         : DatabaseCon(
               setup.standAlone && setup.startUp != Config::LOAD &&
@@ -126,6 +158,16 @@ public:
               pragma,
               initSQL)
     {
+        // Temporary databases are private to the session that created them,
+        // so only regular DB files can be shared with a read pool.
+        if (readConnections > 0 &&
+            (!setup.standAlone || setup.startUp == Config::LOAD ||
+             setup.startUp == Config::LOAD_FILE ||
+             setup.startUp == Config::REPLAY))
+        {
+            setupReaders(
+                setup.dataDir / dbName, setup.commonPragma(), readConnections);
+        }
     }
 
     // Use this constructor to setup checkpointing
@@ -141,6 +183,20 @@ public:
         setupCheckpointing(checkpointerSetup.jobQueue, *checkpointerSetup.logs);
     }
 
+    // Use this constructor to setup checkpointing and a read pool
+    template <std::size_t N, std::size_t M>
+    DatabaseCon(
+        Setup const& setup,
+        std::string const& dbName,
+        std::array<char const*, N> const& pragma,
+        std::array<char const*, M> const& initSQL,
+        CheckpointerSetup const& checkpointerSetup,
+        std::size_t readConnections)
+        : DatabaseCon(setup, dbName, pragma, initSQL, readConnections)
+    {
+        setupCheckpointing(checkpointerSetup.jobQueue, *checkpointerSetup.logs);
+    }
+
     template <std::size_t N, std::size_t M>
     DatabaseCon(
         boost::filesystem::path const& dataDir,
@@ -178,10 +234,30 @@ public:
         return LockedSociSession(session_, lock_);
     }
 
+    /** Check out a session for read-only queries.
+
+        If a read pool was configured, this returns the first idle read-only
+        session, or waits for one if all of them are busy. Reads from the pool
+        observe the last committed state of the database and never contend
+        with the lock held by writers on the main session. Without a pool
+        this is the same as checkoutDb().
+    */
+    LockedSociSession
+    checkoutReadDb();
+
+    ReadStats
+    readStats() const;
+
 private:
     void
     setupCheckpointing(JobQueue*, Logs&);
 
+    void
+    setupReaders(
+        boost::filesystem::path const& pPath,
+        std::vector<std::string> const* commonPragma,
+        std::size_t count);
+
     template <std::size_t N, std::size_t M>
     DatabaseCon(
         boost::filesystem::path const& pPath,
@@ -222,6 +298,19 @@ private:
     // shared_ptr in this class. session_ will never be null.
     std::shared_ptr<soci::session> const session_;
     std::shared_ptr<Checkpointer> checkpointer_;
+
+    struct Reader
+    {
+        std::shared_ptr<soci::session> session;
+        LockedSociSession::mutex mutex;
+    };
+
+    // Read-only sessions used by checkoutReadDb(). Populated once during
+    // construction and never resized afterwards.
+    std::vector<std::unique_ptr<Reader>> readers_;
+    std::atomic<std::size_t> nextReader_{0};
+    std::atomic<std::uint64_t> readCheckouts_{0};
+    std::atomic<std::uint64_t> readWaits_{0};
 };
 
 // Return the checkpointer from its id. If the checkpointer no longer exists, an
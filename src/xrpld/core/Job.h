@@ -54,6 +54,7 @@ enum JobType {
     jtVALIDATION_ut,      // A validation from an untrusted source
     jtMANIFEST,           // A validator's manifest
     jtUPDATE_PF,          // Update pathfinding requests
+    jtPATH_WORK,          // Share of a path search or update
     jtTRANSACTION_l,      // A local transaction
     jtREPLAY_REQ,         // Peer request a ledger delta or a skip list
     jtLEDGER_REQ,         // Peer request ledger/txnset data
@@ -29,6 +29,8 @@
 #include <boost/coroutine/all.hpp>
 #include <boost/range/begin.hpp>  // workaround for boost 1.72 bug
 #include <boost/range/end.hpp>    // workaround for boost 1.72 bug
+#include <coroutine>
+#include <exception>
 
 namespace ripple {
 
@@ -138,6 +140,54 @@ public:
         join();
     };
 
+    /** A stackless coroutine which runs on the JobQueue.
+
+        A CoroTask is the return type of a C++20 coroutine function. Unlike
+        a Coro, it does not own a stack: only the frame of the coroutine
+        function is allocated, so a suspended task costs a few hundred bytes
+        instead of a megabyte of reserved stack.
+
+        The task is started with JobQueue::postCoroTask() and suspends with
+        `co_await jq.suspendCoroTask(...)`. Like a Coro, a CoroTask that
+        has been suspended must be resumed, and run to completion.
+
+        Arguments to the coroutine function are copied into its frame, but
+        references and lambda captures are not: pass state by value.
+    */
+    class CoroTask
+    {
+    public:
+        struct promise_type;
+        using handle_type = std::coroutine_handle<promise_type>;
+
+        class Resumer;
+
+        template <class F>
+        class Awaiter;
+
+        // Not copy-constructible or assignable
+        CoroTask(CoroTask const&) = delete;
+        CoroTask&
+        operator=(CoroTask const&) = delete;
+
+        CoroTask(CoroTask&& other) noexcept;
+        CoroTask&
+        operator=(CoroTask&&) = delete;
+
+        /** Destroys the task if it was never posted. */
+        ~CoroTask();
+
+    private:
+        friend class JobQueue;
+
+        explicit CoroTask(handle_type h) noexcept;
+
+        handle_type
+        release() noexcept;
+
+        handle_type handle_;
+    };
+
     using JobFunction = std::function<void()>;
 
     JobQueue(
@@ -186,6 +236,35 @@ public:
     std::shared_ptr<Coro>
     postCoro(JobType t, std::string const& name, F&& f);
 
+    /** Adds a job to the queue which will start a stackless coroutine.
+
+        @param t The type of job.
+        @param name Name of the job.
+        @param task The value returned by calling a coroutine function. The
+       function body does not run until the job executes.
+
+        @return true if the task was added to the queue. If not, the task is
+       destroyed without running.
+    */
+    bool
+    postCoroTask(JobType t, std::string const& name, CoroTask task);
+
+    /** Suspends the calling CoroTask until it is resumed by a callback.
+
+        Use as `co_await jq.suspendCoroTask(t, name, f)`. Once the task is
+        suspended, `f` is called with a CoroTask::Resumer. Invoking the
+        Resumer, from any thread, adds a job which continues the task after
+        the co_await. Because the task is already suspended when `f` runs,
+        the Resumer may be invoked before `f` returns.
+
+        @param t The type of the job which resumes the task.
+        @param name Name of the job which resumes the task.
+        @param f Has a signature of void(CoroTask::Resumer).
+    */
+    template <class F>
+    CoroTask::Awaiter<std::decay_t<F>>
+    suspendCoroTask(JobType t, std::string const& name, F&& f);
+
     /** Jobs waiting at this priority.
      */
     int
@@ -239,6 +318,13 @@ public:
 
 private:
     friend class Coro;
+    friend class CoroTask::Resumer;
+    template <class F>
+    friend class CoroTask::Awaiter;
+
+    // Restores the LocalValues of the task and continues it on this thread.
+    void
+    resumeCoroTask(CoroTask::handle_type h);
 
     using JobDataMap = std::map<JobType, JobTypeData>;
 
@@ -403,6 +489,7 @@ private:
 }  // namespace ripple
 
 #include <xrpld/core/Coro.ipp>
+#include <xrpld/core/CoroTask.ipp>
 
 namespace ripple {
 
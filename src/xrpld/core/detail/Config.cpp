@@ -649,6 +649,22 @@ Config::loadFromString(std::string const& fileContents)
         PATH_SEARCH_FAST = beast::lexicalCastThrow<int>(strTemp);
     if (getSingleSection(secConfig, SECTION_PATH_SEARCH_MAX, strTemp, j_))
         PATH_SEARCH_MAX = beast::lexicalCastThrow<int>(strTemp);
+    if (getSingleSection(secConfig, SECTION_PATH_RANK_THREADS, strTemp, j_))
+    {
+        PATH_RANK_THREADS = beast::lexicalCastThrow<int>(strTemp);
+        if (PATH_RANK_THREADS < 1)
+            Throw<std::runtime_error>(
+                "Invalid " SECTION_PATH_RANK_THREADS
+                ": must be at least 1");
+    }
+    if (getSingleSection(secConfig, SECTION_PATH_UPDATE_THREADS, strTemp, j_))
+    {
+        PATH_UPDATE_THREADS = beast::lexicalCastThrow<int>(strTemp);
+        if (PATH_UPDATE_THREADS < 1)
+            Throw<std::runtime_error>(
+                "Invalid " SECTION_PATH_UPDATE_THREADS
+                ": must be at least 1");
+    }
 
     if (getSingleSection(secConfig, SECTION_DEBUG_LOGFILE, strTemp, j_))
         DEBUG_LOGFILE = strTemp;
@@ -698,6 +714,19 @@ Config::loadFromString(std::string const& fileContents)
     if (getSingleSection(secConfig, SECTION_LEDGER_REPLAY, strTemp, j_))
         LEDGER_REPLAY = beast::lexicalCastThrow<bool>(strTemp);
 
+    if (exists(SECTION_HISTORY_BACKFILL))
+    {
+        auto const sec = section(SECTION_HISTORY_BACKFILL);
+        BACKFILL_PARALLEL = sec.value_or("parallel", BACKFILL_PARALLEL);
+        BACKFILL_MAX_WRITE_LOAD =
+            sec.value_or("max_write_load", BACKFILL_MAX_WRITE_LOAD);
+        if (BACKFILL_PARALLEL > 256 || BACKFILL_MAX_WRITE_LOAD < 1)
+            Throw<std::runtime_error>(
+                "Invalid " SECTION_HISTORY_BACKFILL
+                ", parallel must be at most 256"
+                ", max_write_load must be positive");
+    }
+
     if (exists(SECTION_REDUCE_RELAY))
     {
         auto sec = section(SECTION_REDUCE_RELAY);
@@ -237,6 +237,8 @@ setup_DatabaseCon(Config const& c, std::optional<beast::Journal> j)
     }
     setup.useGlobalPragma = true;
 
+    set(setup.readConnections, "read_connections", c.section("sqlite"));
+
     return setup;
 }
 
@@ -251,4 +253,71 @@ DatabaseCon::setupCheckpointing(JobQueue* q, Logs& l)
     checkpointer_ = checkpointers.create(session_, *q, l);
 }
 
+void
+DatabaseCon::setupReaders(
+    boost::filesystem::path const& pPath,
+    std::vector<std::string> const* commonPragma,
+    std::size_t count)
+{
+    // Separate connections only read concurrently with the writer when the
+    // database uses a write-ahead log. In any other journal mode they would
+    // just move the contention into SQLite's file locks.
+    std::string mode;
+    *session_ << "PRAGMA journal_mode;", soci::into(mode);
+    if (!boost::iequals(mode, "wal"))
+        return;
+
+    readers_.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        auto reader = std::make_unique<Reader>();
+        reader->session = std::make_shared<soci::session>();
+        open(*reader->session, "sqlite", pPath.string());
+
+        if (commonPragma)
+        {
+            for (auto const& p : *commonPragma)
+            {
+                soci::statement st = reader->session->prepare << p;
+                st.execute(true);
+            }
+        }
+
+        *reader->session << "PRAGMA query_only=1;";
+        readers_.push_back(std::move(reader));
+    }
+}
+
+LockedSociSession
+DatabaseCon::checkoutReadDb()
+{
+    if (readers_.empty())
+        return checkoutDb();
+
+    ++readCheckouts_;
+
+    auto const size = readers_.size();
+    auto const start =
+        nextReader_.fetch_add(1, std::memory_order_relaxed) % size;
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        auto& reader = *readers_[(start + i) % size];
+        std::unique_lock lock(reader.mutex, std::try_to_lock);
+        if (lock.owns_lock())
+            return LockedSociSession(reader.session, std::move(lock));
+    }
+
+    // Every session is busy; queue up behind the one we started from.
+    ++readWaits_;
+    auto& reader = *readers_[start];
+    return LockedSociSession(reader.session, std::unique_lock(reader.mutex));
+}
+
+DatabaseCon::ReadStats
+DatabaseCon::readStats() const
+{
+    return {readers_.size(), readCheckouts_.load(), readWaits_.load()};
+}
+
 }  // namespace ripple
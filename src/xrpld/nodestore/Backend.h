@@ -129,6 +129,15 @@ public:
     virtual void
     for_each(std::function<void(std::shared_ptr<NodeObject>)> f) = 0;
 
+    /** Visit every object in an open database
+        Unlike for_each, the backend stays open, so objects can be fetched
+        while the visit is in progress. Nothing may be stored meanwhile.
+        @param f Called for each object. Returning false ends the visit.
+        @return false if the visit was ended by f.
+    */
+    virtual bool
+    visit(std::function<bool(std::shared_ptr<NodeObject>)> const& f) = 0;
+
     /** Estimate the number of write operations pending. */
     virtual int
     getWriteLoad() = 0;
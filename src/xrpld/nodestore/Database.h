@@ -26,6 +26,8 @@
 #include <xrpl/basics/TaggedCache.h>
 #include <xrpl/protocol/SystemParameters.h>
 
+#include <array>
+#include <chrono>
 #include <condition_variable>
 #include <thread>
 
@@ -239,8 +241,9 @@ protected:
     std::uint32_t const earliestLedgerSeq_;
 
     // The maximum number of requests a thread extracts from the queue in an
-    // attempt to minimize the overhead of mutex acquisition. This is an
-    // advanced tunable, via the config file. The default value is 4.
+    // attempt to minimize the overhead of mutex acquisition. The requests
+    // are then read from the backend as one batch. This is an advanced
+    // tunable, via the config file. The default value is 4.
     int const requestBundle_;
 
     void
@@ -270,6 +273,16 @@ private:
     std::atomic<std::uint64_t> fetchDurationUs_{0};
     std::atomic<std::uint64_t> storeDurationUs_{0};
 
+    // Counts of fetches by latency, with these upper bounds in microseconds
+    static constexpr std::array<std::uint64_t, 5> fetchLatencyBoundsUs_{
+        10,
+        100,
+        1'000,
+        10'000,
+        100'000};
+    std::array<std::atomic<std::uint64_t>, fetchLatencyBoundsUs_.size() + 1>
+        fetchLatency_{};
+
     mutable std::mutex readLock_;
     std::condition_variable readCondVar_;
 
@@ -292,6 +305,30 @@ private:
         FetchReport& fetchReport,
         bool duplicate) = 0;
 
+    /** Fetch several objects for the asynchronous read threads.
+
+        The default fetches each object in turn. Databases whose backends
+        can read a batch faster than its objects one by one override this.
+
+        @param hashes The keys of the objects to retrieve.
+        @param ledgerSeqs The sequence of the ledger for each key.
+        @return One entry for each key, null if it was not found.
+    */
+    virtual std::vector<std::shared_ptr<NodeObject>>
+    fetchNodeObjects(
+        std::vector<uint256> const& hashes,
+        std::vector<std::uint32_t> const& ledgerSeqs);
+
+    // Fetch a batch and report the time it took
+    std::vector<std::shared_ptr<NodeObject>>
+    fetchNodeObjects(
+        std::vector<uint256> const& hashes,
+        std::vector<std::uint32_t> const& ledgerSeqs,
+        FetchType fetchType);
+
+    void
+    recordFetchLatency(std::chrono::microseconds elapsed, std::uint64_t count);
+
     /** Visit every object in the database
         This is usually called during import.
 
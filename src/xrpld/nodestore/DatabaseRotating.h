@@ -22,12 +22,19 @@
 
 #include <xrpld/nodestore/Database.h>
 
+#include <optional>
+
 namespace ripple {
 namespace NodeStore {
 
 /* This class has two key-value store Backend objects for persisting SHAMap
  * records. This facilitates online deletion of data. New backends are
  * rotated in. Old ones are rotated out and deleted.
+ *
+ * Optionally, a third, cold backend keeps everything which is rotated out.
+ * The two rotating backends then hold only recent data, on fast storage,
+ * and the contents of the archive backend are migrated to the cold backend
+ * before it is deleted. Fetches fall back to the cold backend.
  */
 
 class DatabaseRotating : public Database
@@ -49,6 +56,31 @@ public:
     virtual void
     rotateWithLock(std::function<std::unique_ptr<NodeStore::Backend>(
                        std::string const& writableBackendName)> const& f) = 0;
+
+    /** Store objects in the writable backend, unless they are there already.
+
+        Used to carry the objects a ledger needs over to the writable backend
+        before a rotation. The caller holds the objects, so nothing is read
+        from the archive backend.
+
+        @param batch The objects to copy.
+        @return The number of objects which had to be written.
+    */
+    virtual std::size_t
+    copyToWritable(Batch const& batch) = 0;
+
+    /** Move the contents of the archive backend to the cold backend.
+
+        Must be called before a rotation deletes the archive backend. Does
+        nothing if there is no cold backend.
+
+        @param keepGoing Called between batches. Returning false stops the
+                         migration. It is safe to start it again later.
+        @return The number of objects migrated, or std::nullopt if the
+                migration was stopped.
+    */
+    virtual std::optional<std::uint64_t>
+    migrateArchive(std::function<bool()> const& keepGoing) = 0;
 };
 
 }  // namespace NodeStore
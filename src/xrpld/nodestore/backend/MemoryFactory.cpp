@@ -25,6 +25,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 namespace ripple {
 namespace NodeStore {
@@ -192,6 +193,26 @@ public:
             f(e.second);
     }
 
+    bool
+    visit(std::function<bool(std::shared_ptr<NodeObject>)> const& f) override
+    {
+        assert(db_);
+        std::vector<std::shared_ptr<NodeObject>> objects;
+        {
+            std::lock_guard _(db_->mutex);
+            objects.reserve(db_->table.size());
+            for (auto const& e : db_->table)
+                objects.push_back(e.second);
+        }
+
+        for (auto& object : objects)
+        {
+            if (!f(std::move(object)))
+                return false;
+        }
+        return true;
+    }
+
     int
     getWriteLoad() override
     {
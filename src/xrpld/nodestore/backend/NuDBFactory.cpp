@@ -317,6 +317,44 @@ public:
             Throw<nudb::system_error>(ec);
     }
 
+    bool
+    visit(std::function<bool(std::shared_ptr<NodeObject>)> const& f) override
+    {
+        // The data file is read through a handle of its own, so the store
+        // stays open for fetches.
+        bool stopped = false;
+        nudb::error_code ec;
+        nudb::visit(
+            db_.dat_path(),
+            [&](void const* key,
+                std::size_t key_bytes,
+                void const* data,
+                std::size_t size,
+                nudb::error_code& visitEc) {
+                nudb::detail::buffer bf;
+                auto const result = nodeobject_decompress(data, size, bf);
+                DecodedBlob decoded(key, result.first, result.second);
+                if (!decoded.wasOk())
+                {
+                    visitEc = make_error_code(nudb::error::missing_value);
+                    return;
+                }
+                if (!f(decoded.createObject()))
+                {
+                    // Any error ends the visit
+                    stopped = true;
+                    visitEc = make_error_code(nudb::error::missing_value);
+                }
+            },
+            nudb::no_progress{},
+            ec);
+        if (stopped)
+            return false;
+        if (ec)
+            Throw<nudb::system_error>(ec);
+        return true;
+    }
+
     int
     getWriteLoad() override
     {
@@ -63,7 +63,9 @@ public:
     std::pair<std::vector<std::shared_ptr<NodeObject>>, Status>
     fetchBatch(std::vector<uint256 const*> const& hashes) override
     {
-        return {};
+        return {
+            std::vector<std::shared_ptr<NodeObject>>(hashes.size()),
+            notFound};
     }
 
     void
@@ -86,6 +88,12 @@ public:
     {
     }
 
+    bool
+    visit(std::function<bool(std::shared_ptr<NodeObject>)> const&) override
+    {
+        return true;
+    }
+
     int
     getWriteLoad() override
     {
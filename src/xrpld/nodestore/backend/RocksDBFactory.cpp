@@ -325,16 +325,53 @@ public:
     std::pair<std::vector<std::shared_ptr<NodeObject>>, Status>
     fetchBatch(std::vector<uint256 const*> const& hashes) override
     {
+        assert(m_db);
+
+        std::vector<rocksdb::Slice> keys;
+        keys.reserve(hashes.size());
+        for (auto const& h : hashes)
+            keys.emplace_back(
+                reinterpret_cast<char const*>(h->data()), m_keyBytes);
+
+        std::vector<rocksdb::PinnableSlice> values(keys.size());
+        std::vector<rocksdb::Status> statuses(keys.size());
+
+        // One MultiGet lets RocksDB share the index and filter lookups
+        // and issue the reads for the batch in parallel.
+        rocksdb::ReadOptions options;
+#if ROCKSDB_MAJOR > 7 || (ROCKSDB_MAJOR == 7 && ROCKSDB_MINOR >= 6)
+        options.async_io = true;
+#endif
+        m_db->MultiGet(
+            options,
+            m_db->DefaultColumnFamily(),
+            keys.size(),
+            keys.data(),
+            values.data(),
+            statuses.data());
+
         std::vector<std::shared_ptr<NodeObject>> results;
         results.reserve(hashes.size());
-        for (auto const& h : hashes)
+        for (std::size_t i = 0; i < hashes.size(); ++i)
         {
-            std::shared_ptr<NodeObject> nObj;
-            Status status = fetch(h->begin(), &nObj);
-            if (status != ok)
-                results.push_back({});
-            else
-                results.push_back(nObj);
+            auto const& getStatus = statuses[i];
+            if (getStatus.ok())
+            {
+                DecodedBlob decoded(
+                    hashes[i]->data(), values[i].data(), values[i].size());
+                if (decoded.wasOk())
+                {
+                    results.push_back(decoded.createObject());
+                    continue;
+                }
+                // Decoding failed, probably corrupted!
+                JLOG(m_journal.error()) << "Corrupt NodeObject #" << *hashes[i];
+            }
+            else if (!getStatus.IsNotFound())
+            {
+                JLOG(m_journal.error()) << getStatus.ToString();
+            }
+            results.push_back({});
         }
 
         return {results, ok};
@@ -414,6 +451,38 @@ public:
         }
     }
 
+    bool
+    visit(std::function<bool(std::shared_ptr<NodeObject>)> const& f) override
+    {
+        assert(m_db);
+        rocksdb::ReadOptions const options;
+
+        std::unique_ptr<rocksdb::Iterator> it(m_db->NewIterator(options));
+
+        for (it->SeekToFirst(); it->Valid(); it->Next())
+        {
+            if (it->key().size() != m_keyBytes)
+            {
+                JLOG(m_journal.fatal())
+                    << "Bad key size = " << it->key().size();
+                continue;
+            }
+
+            DecodedBlob decoded(
+                it->key().data(), it->value().data(), it->value().size());
+            if (!decoded.wasOk())
+            {
+                JLOG(m_journal.fatal())
+                    << "Corrupt NodeObject #" << it->key().ToString(true);
+                continue;
+            }
+
+            if (!f(decoded.createObject()))
+                return false;
+        }
+        return true;
+    }
+
     int
     getWriteLoad() override
     {
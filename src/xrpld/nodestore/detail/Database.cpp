@@ -58,6 +58,8 @@ Database::Database(
                     "db prefetch #" + std::to_string(i));
 
                 decltype(read_) read;
+                std::vector<uint256> hashes;
+                std::vector<std::uint32_t> seqs;
 
                 while (true)
                 {
@@ -85,16 +87,26 @@ Database::Database(
                             read.insert(read_.extract(read_.begin()));
                     }
 
-                    for (auto it = read.begin(); it != read.end(); ++it)
+                    hashes.clear();
+                    seqs.clear();
+                    for (auto const& [hash, data] : read)
                     {
-                        assert(!it->second.empty());
+                        assert(!data.empty());
+                        hashes.push_back(hash);
+                        seqs.push_back(data[0].first);
+                    }
+
+                    // Read the whole bundle from the backend at once.
+                    auto const objs =
+                        fetchNodeObjects(hashes, seqs, FetchType::async);
 
+                    std::size_t i = 0;
+                    for (auto it = read.begin(); it != read.end(); ++it, ++i)
+                    {
                         auto const& hash = it->first;
                         auto const& data = it->second;
-                        auto const seqn = data[0].first;
-
-                        auto obj =
-                            fetchNodeObject(hash, seqn, FetchType::async);
+                        auto const seqn = seqs[i];
+                        auto const& obj = objs[i];
 
                         // This could be further optimized: if there are
                         // multiple requests for sequence numbers mapping to
@@ -241,6 +253,7 @@ Database::fetchNodeObject(
     auto nodeObject{fetchNodeObject(hash, ledgerSeq, fetchReport, duplicate)};
     auto dur = steady_clock::now() - begin;
     fetchDurationUs_ += duration_cast<microseconds>(dur).count();
+    recordFetchLatency(duration_cast<microseconds>(dur), 1);
     if (nodeObject)
     {
         ++fetchHitCount_;
@@ -253,6 +266,80 @@ Database::fetchNodeObject(
     return nodeObject;
 }
 
+std::vector<std::shared_ptr<NodeObject>>
+Database::fetchNodeObjects(
+    std::vector<uint256> const& hashes,
+    std::vector<std::uint32_t> const& ledgerSeqs)
+{
+    assert(hashes.size() == ledgerSeqs.size());
+    std::vector<std::shared_ptr<NodeObject>> results;
+    results.reserve(hashes.size());
+    for (std::size_t i = 0; i < hashes.size(); ++i)
+    {
+        FetchReport fetchReport(FetchType::async);
+        results.push_back(
+            fetchNodeObject(hashes[i], ledgerSeqs[i], fetchReport, false));
+    }
+    return results;
+}
+
+// Perform a batch fetch and report the time it took
+std::vector<std::shared_ptr<NodeObject>>
+Database::fetchNodeObjects(
+    std::vector<uint256> const& hashes,
+    std::vector<std::uint32_t> const& ledgerSeqs,
+    FetchType fetchType)
+{
+    if (hashes.empty())
+        return {};
+
+    using namespace std::chrono;
+    auto const begin{steady_clock::now()};
+
+    auto results{fetchNodeObjects(hashes, ledgerSeqs)};
+    assert(results.size() == hashes.size());
+    auto const dur = steady_clock::now() - begin;
+    auto const us = duration_cast<microseconds>(dur);
+
+    std::uint64_t hits = 0;
+    std::uint64_t sz = 0;
+    for (auto const& nodeObject : results)
+    {
+        if (nodeObject)
+        {
+            ++hits;
+            sz += nodeObject->getData().size();
+        }
+    }
+    updateFetchMetrics(results.size(), hits, us.count());
+    fetchSz_ += sz;
+    // Every request in the batch waited for all of it.
+    recordFetchLatency(us, results.size());
+
+    // The scheduler sees each object, with its share of the time.
+    for (auto const& nodeObject : results)
+    {
+        FetchReport fetchReport(fetchType);
+        fetchReport.wasFound = static_cast<bool>(nodeObject);
+        fetchReport.elapsed = duration_cast<milliseconds>(dur / results.size());
+        scheduler_.onFetch(fetchReport);
+    }
+    return results;
+}
+
+void
+Database::recordFetchLatency(
+    std::chrono::microseconds elapsed,
+    std::uint64_t count)
+{
+    auto const us = static_cast<std::uint64_t>(elapsed.count());
+    std::size_t bucket = 0;
+    while (bucket < fetchLatencyBoundsUs_.size() &&
+           us > fetchLatencyBoundsUs_[bucket])
+        ++bucket;
+    fetchLatency_[bucket] += count;
+}
+
 void
 Database::getCountsJson(Json::Value& obj)
 {
@@ -273,6 +360,17 @@ Database::getCountsJson(Json::Value& obj)
     obj[jss::node_written_bytes] = std::to_string(storeSz_);
     obj[jss::node_read_bytes] = std::to_string(fetchSz_);
     obj[jss::node_reads_duration_us] = std::to_string(fetchDurationUs_);
+
+    // Fetches by latency, keyed by the upper bound in microseconds
+    Json::Value latency(Json::objectValue);
+    for (std::size_t i = 0; i < fetchLatency_.size(); ++i)
+    {
+        auto const key = i < fetchLatencyBoundsUs_.size()
+            ? std::to_string(fetchLatencyBoundsUs_[i])
+            : std::string("max");
+        latency[key] = std::to_string(fetchLatency_[i]);
+    }
+    obj[jss::node_reads_latency_us] = latency;
 }
 
 }  // namespace NodeStore
@@ -145,71 +145,84 @@ DatabaseNodeImp::fetchNodeObject(
 std::vector<std::shared_ptr<NodeObject>>
 DatabaseNodeImp::fetchBatch(std::vector<uint256> const& hashes)
 {
-    std::vector<std::shared_ptr<NodeObject>> results{hashes.size()};
     using namespace std::chrono;
     auto const before = steady_clock::now();
-    std::unordered_map<uint256 const*, size_t> indexMap;
-    std::vector<uint256 const*> cacheMisses;
+    auto results =
+        fetchNodeObjects(hashes, std::vector<std::uint32_t>(hashes.size()));
+
     uint64_t hits = 0;
-    uint64_t fetches = 0;
+    for (auto const& nObj : results)
+    {
+        if (nObj)
+            ++hits;
+    }
+    auto fetchDurationUs =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            steady_clock::now() - before)
+            .count();
+    updateFetchMetrics(hashes.size(), hits, fetchDurationUs);
+    return results;
+}
+
+std::vector<std::shared_ptr<NodeObject>>
+DatabaseNodeImp::fetchNodeObjects(
+    std::vector<uint256> const& hashes,
+    std::vector<std::uint32_t> const&)
+{
+    std::vector<std::shared_ptr<NodeObject>> results{hashes.size()};
+    std::vector<size_t> indexes;
+    std::vector<uint256 const*> cacheMisses;
     for (size_t i = 0; i < hashes.size(); ++i)
     {
         auto const& hash = hashes[i];
         // See if the object already exists in the cache
         auto nObj = cache_ ? cache_->fetch(hash) : nullptr;
-        ++fetches;
         if (!nObj)
         {
             // Try the database
-            indexMap[&hash] = i;
+            indexes.push_back(i);
             cacheMisses.push_back(&hash);
         }
         else
         {
             results[i] = nObj->getType() == hotDUMMY ? nullptr : nObj;
-            // It was in the cache.
-            ++hits;
         }
     }
 
-    JLOG(j_.debug()) << "fetchBatch - cache hits = "
+    JLOG(j_.trace()) << "fetchNodeObjects - cache hits = "
                      << (hashes.size() - cacheMisses.size())
                      << " - cache misses = " << cacheMisses.size();
-    auto dbResults = backend_->fetchBatch(cacheMisses).first;
+    if (cacheMisses.empty())
+        return results;
+
+    std::vector<std::shared_ptr<NodeObject>> dbResults;
+    try
+    {
+        dbResults = backend_->fetchBatch(cacheMisses).first;
+    }
+    catch (std::exception const& e)
+    {
+        JLOG(j_.fatal()) << "fetchNodeObjects: Exception fetching from "
+                         << "backend: " << e.what();
+        Rethrow();
+    }
 
     for (size_t i = 0; i < dbResults.size(); ++i)
     {
         auto nObj = std::move(dbResults[i]);
-        size_t index = indexMap[cacheMisses[i]];
+        size_t const index = indexes[i];
         auto const& hash = hashes[index];
 
-        if (nObj)
+        // As fetchNodeObject, a missing record is not cached: it may
+        // be about to arrive from the network.
+        if (nObj && cache_)
         {
             // Ensure all threads get the same object
-            if (cache_)
-                cache_->canonicalize_replace_client(hash, nObj);
-        }
-        else
-        {
-            JLOG(j_.error())
-                << "fetchBatch - "
-                << "record not found in db or cache. hash = " << strHex(hash);
-            if (cache_)
-            {
-                auto notFound = NodeObject::createObject(hotDUMMY, {}, hash);
-                cache_->canonicalize_replace_client(hash, notFound);
-                if (notFound->getType() != hotDUMMY)
-                    nObj = std::move(notFound);
-            }
+            cache_->canonicalize_replace_client(hash, nObj);
         }
         results[index] = std::move(nObj);
     }
 
-    auto fetchDurationUs =
-        std::chrono::duration_cast<std::chrono::microseconds>(
-            steady_clock::now() - before)
-            .count();
-    updateFetchMetrics(fetches, hits, fetchDurationUs);
     return results;
 }
 
@@ -145,6 +145,11 @@ private:
         FetchReport& fetchReport,
         bool duplicate) override;
 
+    std::vector<std::shared_ptr<NodeObject>>
+    fetchNodeObjects(
+        std::vector<uint256> const& hashes,
+        std::vector<std::uint32_t> const& ledgerSeqs) override;
+
     void
     for_each(std::function<void(std::shared_ptr<NodeObject>)> f) override
     {
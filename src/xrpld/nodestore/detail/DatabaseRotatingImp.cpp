@@ -28,16 +28,20 @@ DatabaseRotatingImp::DatabaseRotatingImp(
     int readThreads,
     std::shared_ptr<Backend> writableBackend,
     std::shared_ptr<Backend> archiveBackend,
+    std::shared_ptr<Backend> coldBackend,
     Section const& config,
     beast::Journal j)
     : DatabaseRotating(scheduler, readThreads, config, j)
     , writableBackend_(std::move(writableBackend))
     , archiveBackend_(std::move(archiveBackend))
+    , coldBackend_(std::move(coldBackend))
 {
     if (writableBackend_)
         fdRequired_ += writableBackend_->fdRequired();
     if (archiveBackend_)
         fdRequired_ += archiveBackend_->fdRequired();
+    if (coldBackend_)
+        fdRequired_ += coldBackend_->fdRequired();
 }
 
 void
@@ -53,6 +57,104 @@ DatabaseRotatingImp::rotateWithLock(
     writableBackend_ = std::move(newBackend);
 }
 
+std::size_t
+DatabaseRotatingImp::copyToWritable(Batch const& batch)
+{
+    if (batch.empty())
+        return 0;
+
+    auto const writable = [&] {
+        std::lock_guard lock(mutex_);
+        return writableBackend_;
+    }();
+
+    std::vector<uint256 const*> keys;
+    keys.reserve(batch.size());
+    for (auto const& nodeObject : batch)
+        keys.push_back(&nodeObject->getHash());
+
+    std::vector<std::shared_ptr<NodeObject>> found;
+    try
+    {
+        found = writable->fetchBatch(keys).first;
+    }
+    catch (std::exception const& e)
+    {
+        JLOG(j_.fatal()) << "Exception, " << e.what();
+        Rethrow();
+    }
+
+    // Only write what the writable backend does not already hold
+    Batch missing;
+    missing.reserve(batch.size());
+    std::uint64_t bytes = 0;
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+        if (i < found.size() && found[i])
+            continue;
+        bytes += batch[i]->getData().size();
+        missing.push_back(batch[i]);
+    }
+
+    if (!missing.empty())
+    {
+        writable->storeBatch(missing);
+        storeStats(missing.size(), bytes);
+    }
+
+    return missing.size();
+}
+
+std::optional<std::uint64_t>
+DatabaseRotatingImp::migrateArchive(std::function<bool()> const& keepGoing)
+{
+    if (!coldBackend_)
+        return 0;
+
+    auto const archive = [&] {
+        std::lock_guard lock(mutex_);
+        return archiveBackend_;
+    }();
+
+    Batch batch;
+    batch.reserve(batchWritePreallocationSize);
+    std::uint64_t migrated = 0;
+    auto flush = [&] {
+        coldBackend_->storeBatch(batch);
+        migrated += batch.size();
+        batch.clear();
+    };
+
+    // Nothing is written to the archive any more, so it can be walked while
+    // it stays open and continues to serve fetches.
+    try
+    {
+        bool const finished =
+            archive->visit([&](std::shared_ptr<NodeObject> nodeObject) {
+                batch.push_back(std::move(nodeObject));
+                if (batch.size() < batchWritePreallocationSize)
+                    return true;
+                flush();
+                return keepGoing();
+            });
+        if (!finished)
+            return std::nullopt;
+    }
+    catch (std::exception const& e)
+    {
+        JLOG(j_.fatal()) << "Exception migrating " << archive->getName()
+                         << ": " << e.what();
+        Rethrow();
+    }
+
+    if (!batch.empty())
+        flush();
+
+    // The archive may be deleted as soon as this returns
+    coldBackend_->sync();
+    return migrated;
+}
+
 std::string
 DatabaseRotatingImp::getName() const
 {
@@ -159,6 +261,11 @@ DatabaseRotatingImp::fetchNodeObject(
     {
         // Otherwise try to fetch from the archive backend
         nodeObject = fetch(archive);
+
+        // Otherwise try to fetch from the cold backend
+        if (!nodeObject && coldBackend_)
+            nodeObject = fetch(coldBackend_);
+
         if (nodeObject)
         {
             {
@@ -179,6 +286,79 @@ DatabaseRotatingImp::fetchNodeObject(
     return nodeObject;
 }
 
+std::vector<std::shared_ptr<NodeObject>>
+DatabaseRotatingImp::fetchNodeObjects(
+    std::vector<uint256> const& hashes,
+    std::vector<std::uint32_t> const&)
+{
+    auto fetch = [&](std::shared_ptr<Backend> const& backend,
+                     std::vector<uint256 const*> const& keys) {
+        try
+        {
+            return backend->fetchBatch(keys).first;
+        }
+        catch (std::exception const& e)
+        {
+            JLOG(j_.fatal()) << "Exception, " << e.what();
+            Rethrow();
+        }
+    };
+
+    auto [writable, archive] = [&] {
+        std::lock_guard lock(mutex_);
+        return std::make_pair(writableBackend_, archiveBackend_);
+    }();
+
+    std::vector<uint256 const*> keys;
+    keys.reserve(hashes.size());
+    for (auto const& hash : hashes)
+        keys.push_back(&hash);
+
+    // Try to fetch from the writable backend
+    auto results = fetch(writable, keys);
+
+    // Otherwise try to fetch from the archive backend
+    std::vector<std::size_t> indexes;
+    keys.clear();
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        if (!results[i])
+        {
+            indexes.push_back(i);
+            keys.push_back(&hashes[i]);
+        }
+    }
+    if (!keys.empty())
+    {
+        auto archived = fetch(archive, keys);
+        for (std::size_t i = 0; i < archived.size(); ++i)
+            results[indexes[i]] = std::move(archived[i]);
+    }
+
+    // Otherwise try to fetch from the cold backend
+    if (coldBackend_ && !keys.empty())
+    {
+        std::vector<std::size_t> coldIndexes;
+        keys.clear();
+        for (auto const i : indexes)
+        {
+            if (!results[i])
+            {
+                coldIndexes.push_back(i);
+                keys.push_back(&hashes[i]);
+            }
+        }
+        if (!keys.empty())
+        {
+            auto cold = fetch(coldBackend_, keys);
+            for (std::size_t i = 0; i < cold.size(); ++i)
+                results[coldIndexes[i]] = std::move(cold[i]);
+        }
+    }
+
+    return results;
+}
+
 void
 DatabaseRotatingImp::for_each(
     std::function<void(std::shared_ptr<NodeObject>)> f)
@@ -193,6 +373,10 @@ DatabaseRotatingImp::for_each(
 
     // Iterate the archive backend
     archive->for_each(f);
+
+    // Iterate the cold backend
+    if (coldBackend_)
+        coldBackend_->for_each(f);
 }
 
 }  // namespace NodeStore
@@ -40,6 +40,7 @@ public:
         int readThreads,
         std::shared_ptr<Backend> writableBackend,
         std::shared_ptr<Backend> archiveBackend,
+        std::shared_ptr<Backend> coldBackend,
         Section const& config,
         beast::Journal j);
 
@@ -53,6 +54,12 @@ public:
         std::function<std::unique_ptr<NodeStore::Backend>(
             std::string const& writableBackendName)> const& f) override;
 
+    std::size_t
+    copyToWritable(Batch const& batch) override;
+
+    std::optional<std::uint64_t>
+    migrateArchive(std::function<bool()> const& keepGoing) override;
+
     std::string
     getName() const override;
 
@@ -81,6 +88,8 @@ public:
 private:
     std::shared_ptr<Backend> writableBackend_;
     std::shared_ptr<Backend> archiveBackend_;
+    // Optional. Receives the archive backend's contents before deletion.
+    std::shared_ptr<Backend> const coldBackend_;
     // This needs to be a recursive mutex because callbacks in `rotateWithLock`
     // can call function that also lock the mutex. A current example of this is
     // a callback from SHAMapStoreImp, which calls `clearCaches`. This
@@ -96,6 +105,11 @@ private:
         FetchReport& fetchReport,
         bool duplicate) override;
 
+    std::vector<std::shared_ptr<NodeObject>>
+    fetchNodeObjects(
+        std::vector<uint256> const& hashes,
+        std::vector<std::uint32_t> const& ledgerSeqs) override;
+
     void
     for_each(std::function<void(std::shared_ptr<NodeObject>)> f) override;
 };
@@ -21,6 +21,7 @@
 #include <xrpld/app/ledger/InboundLedgers.h>
 #include <xrpld/app/ledger/InboundTransactions.h>
 #include <xrpld/app/ledger/LedgerMaster.h>
+#include <xrpld/app/ledger/LedgerReplayer.h>
 #include <xrpld/app/ledger/TransactionMaster.h>
 #include <xrpld/app/misc/HashRouter.h>
 #include <xrpld/app/misc/LoadFeeTrack.h>
@@ -1485,10 +1486,39 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMReplayDeltaResponse> const& m)
         return;
     }
 
-    if (!ledgerReplayMsgHandler_.processReplayDeltaResponse(m))
+    // Only the ledger hash is looked at here, the response is verified
+    // against it below.
+    if (!stringIsUint256Sized(m->ledgerhash()) ||
+        !app_.getLedgerReplayer().wantsReplayDelta(
+            uint256{m->ledgerhash()}))
     {
-        charge(Resource::feeBadData);
+        JLOG(p_journal_.debug()) << "TMReplayDeltaResponse: unsolicited";
+        charge(Resource::feeUnwantedData);
+        return;
+    }
+
+    // Verifying a delta hashes all its transactions, so responses are
+    // verified in parallel off the peer's strand. The jobs share their
+    // type with the replay timers, so when too many are queued the
+    // response is verified here instead.
+    if (app_.getJobQueue().getJobCountTotal(jtREPLAY_TASK) >=
+        LedgerReplayParameters::MAX_QUEUED_TASKS)
+    {
+        if (!ledgerReplayMsgHandler_.processReplayDeltaResponse(m))
+            charge(Resource::feeBadData);
+        return;
     }
+
+    std::weak_ptr<PeerImp> weak = shared_from_this();
+    app_.getJobQueue().addJob(
+        jtREPLAY_TASK, "recvReplayDeltaResponse", [weak, m]() {
+            if (auto peer = weak.lock())
+            {
+                if (!peer->ledgerReplayMsgHandler_.processReplayDeltaResponse(
+                        m))
+                    peer->charge(Resource::feeBadData);
+            }
+        });
 }
 
 void
@@ -27,6 +27,9 @@
 
 #include <xrpl/beast/utility/Journal.h>
 
+#include <functional>
+#include <optional>
+
 namespace ripple {
 
 class Application;
@@ -61,9 +64,23 @@ struct JsonContext : public Context
         std::string_view forwardedFor;
     };
 
+    /**
+     * Work left by a handler which has to wait for another job, when it
+     * runs without a Coro to yield. The caller suspends its CoroTask and
+     * passes `start` a callback that resumes it, which is invoked exactly
+     * once. Once resumed, `finish` returns the result of the command.
+     */
+    struct Deferred
+    {
+        std::function<void(std::function<void()>)> start;
+        std::function<Json::Value()> finish;
+    };
+
     Json::Value params;
 
     Headers headers{};
+
+    std::optional<Deferred> deferred{};
 };
 
 template <class RequestType>
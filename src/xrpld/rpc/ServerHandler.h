@@ -190,11 +190,8 @@ public:
     onStopped(Server&);
 
 private:
-    Json::Value
-    processSession(
-        std::shared_ptr<WSSession> const& session,
-        std::shared_ptr<JobQueue::Coro> const& coro,
-        Json::Value const& jv);
+    JobQueue::CoroTask
+    processSession(std::shared_ptr<WSSession> session, Json::Value jv);
 
     void
     processSession(
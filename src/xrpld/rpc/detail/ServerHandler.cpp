@@ -341,22 +341,10 @@ ServerHandler::onWSMessage(
 
     JLOG(m_journal.trace()) << "Websocket received '" << jv << "'";
 
-    auto const postResult = m_jobQueue.postCoro(
-        jtCLIENT_WEBSOCKET,
-        "WS-Client",
-        [this, session, jv = std::move(jv)](
-            std::shared_ptr<JobQueue::Coro> const& coro) {
-            auto const jr = this->processSession(session, coro, jv);
-            auto const s = to_string(jr);
-            auto const n = s.length();
-            boost::beast::multi_buffer sb(n);
-            sb.commit(boost::asio::buffer_copy(
-                sb.prepare(n), boost::asio::buffer(s.c_str(), n)));
-            session->send(
-                std::make_shared<StreambufWSMsg<decltype(sb)>>(std::move(sb)));
-            session->complete();
-        });
-    if (postResult == nullptr)
+    if (!m_jobQueue.postCoroTask(
+            jtCLIENT_WEBSOCKET,
+            "WS-Client",
+            processSession(session, std::move(jv))))
     {
         // The coroutine was rejected, probably because we're shutting down.
         session->close({boost::beast::websocket::going_away, "Shutting Down"});
@@ -399,12 +387,23 @@ logDuration(
                 << " microseconds. request = " << request;
 }
 
-Json::Value
+// Run as a coroutine.
+JobQueue::CoroTask
 ServerHandler::processSession(
-    std::shared_ptr<WSSession> const& session,
-    std::shared_ptr<JobQueue::Coro> const& coro,
-    Json::Value const& jv)
+    std::shared_ptr<WSSession> session,
+    Json::Value jv)
 {
+    auto const respond = [&session](Json::Value const& jr) {
+        auto const s = to_string(jr);
+        auto const n = s.length();
+        boost::beast::multi_buffer sb(n);
+        sb.commit(boost::asio::buffer_copy(
+            sb.prepare(n), boost::asio::buffer(s.c_str(), n)));
+        session->send(
+            std::make_shared<StreambufWSMsg<decltype(sb)>>(std::move(sb)));
+        session->complete();
+    };
+
     auto is = std::static_pointer_cast<WSInfoSub>(session->appDefined);
     if (is->getConsumer().disconnect(m_journal))
     {
@@ -412,7 +411,8 @@ ServerHandler::processSession(
             {boost::beast::websocket::policy_error, "threshold exceeded"});
         // FIX: This rpcError is not delivered since the session
         // was just closed.
-        return rpcError(rpcSLOW_DOWN);
+        respond(rpcError(rpcSLOW_DOWN));
+        co_return;
     }
 
     // Requests without "command" are invalid.
@@ -445,7 +445,8 @@ ServerHandler::processSession(
                 jr[jss::api_version] = jv[jss::api_version];
 
             is->getConsumer().charge(Resource::feeInvalidRPC);
-            return jr;
+            respond(jr);
+            co_return;
         }
 
         auto required = RPC::roleRequired(
@@ -474,7 +475,7 @@ ServerHandler::processSession(
                  app_.getLedgerMaster(),
                  is->getConsumer(),
                  role,
-                 coro,
+                 {},
                  is,
                  apiVersion},
                 jv,
@@ -482,6 +483,20 @@ ServerHandler::processSession(
 
             auto start = std::chrono::system_clock::now();
             RPC::doCommand(context, jr[jss::result]);
+            if (context.deferred)
+            {
+                // The handler is waiting for another job. The callback
+                // is moved out of the frame, which can be destroyed as
+                // soon as the task is resumed.
+                co_await m_jobQueue.suspendCoroTask(
+                    jtCLIENT_WEBSOCKET,
+                    "WS-Client",
+                    [start = context.deferred->start](
+                        JobQueue::CoroTask::Resumer resume) {
+                        start(std::move(resume));
+                    });
+                jr[jss::result] = context.deferred->finish();
+            }
             auto end = std::chrono::system_clock::now();
             logDuration(jv, end - start, m_journal);
         }
@@ -542,7 +557,7 @@ ServerHandler::processSession(
         jr[jss::api_version] = jv[jss::api_version];
 
     jr[jss::type] = jss::response;
-    return jr;
+    respond(jr);
 }
 
 // Run as a coroutine.
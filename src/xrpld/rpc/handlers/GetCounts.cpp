@@ -20,6 +20,9 @@
 #include <xrpld/app/ledger/AcceptedLedger.h>
 #include <xrpld/app/ledger/InboundLedgers.h>
 #include <xrpld/app/ledger/LedgerMaster.h>
+#include <xrpld/app/ledger/LedgerReplayer.h>
+#include <xrpld/app/ledger/OpenLedger.h>
+#include <xrpld/app/ledger/PendingSaves.h>
 #include <xrpld/app/main/Application.h>
 #include <xrpld/app/misc/NetworkOPs.h>
 #include <xrpld/app/rdb/backend/SQLiteDatabase.h>
@@ -94,6 +97,15 @@ getCountsJson(Application& app, int minObjectCount)
         if (dbKB > 0)
             ret[jss::dbKBTransaction] = dbKB;
 
+        if (auto const pool = db->getTransactionReadPoolStats();
+            pool.sessions > 0)
+        {
+            ret[jss::dbTxReadSessions] = static_cast<Json::UInt>(pool.sessions);
+            ret[jss::dbTxReadCheckouts] =
+                static_cast<Json::UInt>(pool.checkouts);
+            ret[jss::dbTxReadWaits] = static_cast<Json::UInt>(pool.waits);
+        }
+
         {
             std::size_t c = app.getOPs().getLocalTxCount();
             if (c > 0)
@@ -102,11 +114,41 @@ getCountsJson(Application& app, int minObjectCount)
     }
 
     ret[jss::write_load] = app.getNodeStore().getWriteLoad();
+    ret[jss::pending_saves] =
+        static_cast<Json::UInt>(app.pendingSaves().size());
 
     ret[jss::historical_perminute] =
         static_cast<int>(app.getInboundLedgers().fetchRate());
     ret[jss::SLE_hit_rate] = app.cachedSLEs().rate();
     ret[jss::ledger_hit_rate] = app.getLedgerMaster().getCacheHitRate();
+    ret[jss::book_page_hit_rate] = app.getOPs().getBookPageCacheHitRate();
+    {
+        using namespace std::chrono;
+        auto const replay = app.openLedger().getReplayStats();
+        ret[jss::open_ledger_replayed] =
+            static_cast<Json::UInt>(replay.replayed);
+        ret[jss::open_ledger_replay_ms] = static_cast<Json::UInt>(
+            duration_cast<milliseconds>(replay.replayTime).count());
+        ret[jss::open_ledger_replayed_locked] =
+            static_cast<Json::UInt>(replay.replayedLocked);
+        ret[jss::open_ledger_replay_locked_ms] = static_cast<Json::UInt>(
+            duration_cast<milliseconds>(replay.replayLockedTime).count());
+    }
+    {
+        using namespace std::chrono;
+        auto const catchUp = app.getLedgerReplayer().getCatchUpStats();
+        ret[jss::ledger_replay_gaps] =
+            static_cast<Json::UInt>(catchUp.replays);
+        ret[jss::ledger_replay_ledgers] =
+            static_cast<Json::UInt>(catchUp.replayLedgers);
+        ret[jss::ledger_replay_skipped_gaps] =
+            static_cast<Json::UInt>(catchUp.skips);
+        ret[jss::ledger_replay_skipped_ledgers] =
+            static_cast<Json::UInt>(catchUp.skipLedgers);
+        ret[jss::ledger_replay_built] = static_cast<Json::UInt>(catchUp.built);
+        ret[jss::ledger_replay_build_ms] = static_cast<Json::UInt>(
+            duration_cast<milliseconds>(catchUp.buildTime).count());
+    }
     ret[jss::AL_size] = Json::UInt(app.getAcceptedLedgerCache().size());
     ret[jss::AL_hit_rate] = app.getAcceptedLedgerCache().getHitRate();
 
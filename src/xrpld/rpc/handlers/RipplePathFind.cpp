@@ -25,6 +25,9 @@
 #include <xrpl/protocol/RPCErr.h>
 #include <xrpl/resource/Fees.h>
 
+#include <atomic>
+#include <functional>
+
 namespace ripple {
 
 // This interface is deprecated.
@@ -39,15 +42,19 @@ doRipplePathFind(RPC::JsonContext& context)
     std::shared_ptr<ReadView const> lpLedger;
     Json::Value jvResult;
 
-    if (!context.app.config().standalone() &&
+    // A standalone server finds paths in the current ledger instead, unless
+    // the request has no Coro to block, such as one from a websocket.
+    bool const standalone = context.app.config().standalone();
+    if ((!standalone || !context.coro) &&
         !context.params.isMember(jss::ledger) &&
         !context.params.isMember(jss::ledger_index) &&
         !context.params.isMember(jss::ledger_hash))
     {
         // No ledger specified, use pathfinding defaults
         // and dispatch to pathfinding engine
-        if (context.app.getLedgerMaster().getValidatedLedgerAge() >
-            RPC::Tuning::maxValidatedLedgerAge)
+        if (!standalone &&
+            context.app.getLedgerMaster().getValidatedLedgerAge() >
+                RPC::Tuning::maxValidatedLedgerAge)
         {
             if (context.apiVersion == 1)
                 return rpcError(rpcNO_NETWORK);
@@ -57,6 +64,49 @@ doRipplePathFind(RPC::JsonContext& context)
         PathRequest::pointer request;
         lpLedger = context.ledgerMaster.getClosedLedger();
 
+        if (!context.coro)
+        {
+            // There is no Coro to yield, so leave the wait to the CoroTask
+            // of the caller. The path-finding job and makeLegacyPathRequest
+            // each drop a reference to `pending` once they are done with the
+            // state, and whichever is last resumes the task.
+            struct State
+            {
+                Json::Value result;
+                PathRequest::pointer request;
+                std::atomic<int> pending{2};
+                std::function<void()> resume;
+            };
+            auto const state = std::make_shared<State>();
+
+            context.deferred.emplace();
+            context.deferred->start =
+                [&context, lpLedger, state](std::function<void()> resume) {
+                    state->resume = std::move(resume);
+                    auto const done = [state]() {
+                        if (--state->pending == 0)
+                            state->resume();
+                    };
+                    state->result =
+                        context.app.getPathRequests().makeLegacyPathRequest(
+                            state->request,
+                            done,
+                            context.consumer,
+                            lpLedger,
+                            context.params);
+                    // Without a request, the path-finding job never runs.
+                    if (!state->request)
+                        done();
+                    done();
+                };
+            context.deferred->finish = [&context, state]() -> Json::Value {
+                if (state->request)
+                    return state->request->doStatus(context.params);
+                return std::move(state->result);
+            };
+            return Json::Value();
+        }
+
         // It doesn't look like there's much odd happening here, but you should
         // be aware this code runs in a JobQueue::Coro, which is a coroutine.
         // And we may be flipping around between threads.  Here's an overview:
@@ -44,6 +44,7 @@
 #include <rocksdb/transaction_log.h>
 #include <rocksdb/types.h>
 #include <rocksdb/universal_compaction.h>
+#include <rocksdb/version.h>
 #include <rocksdb/write_batch.h>
 
 #endif